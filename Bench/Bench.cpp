@@ -0,0 +1,303 @@
+#include "GameManager.h"
+#include "GameBoard.h"
+#include "GameBoardSatelliteView.h"
+#include "HybridTankAlgorithm.h"
+#include "SimpleBattleInfo.h"
+#include "Simulator/MapParser.h"
+#include "Simulator/WorkStealingPool.h"
+#include "UserCommon/MapData.h"
+#include "UserCommon/StateHashable.h"
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include <sys/resource.h>
+
+// Throughput benchmark of the game engine: runs a fixed corpus of maps through GameManager::run with
+// HybridTankAlgorithm on both sides, at 1..N worker threads, and prints the measurements as JSON, along with the
+// time of a GameBoard::fork of a 100x100 board with 50 shells in flight.
+//
+// Usage: bench [maps=<folder>] [threads=<N>] [generated=<count>] [repeat=<count>] [seed=<n>] [fast_forward=0|1]
+
+namespace {
+
+constexpr int kRecalculateInterval = 4; ///< HybridTankAlgorithm path recalculation interval
+constexpr int kShellThreatRadius = 3;   ///< HybridTankAlgorithm shell threat radius
+constexpr int kAskForInfoInterval = 5;  ///< HybridTankAlgorithm battle info interval
+constexpr int kForkBoardSize = 100;     ///< Rows and columns of the board GameBoard::fork is timed on
+constexpr size_t kForkShells = 50;      ///< Shells in flight on that board
+constexpr int kForks = 10000;           ///< Forks timed per measurement
+
+/**
+ * @brief Benchmark settings, parsed from key=value arguments.
+ */
+struct BenchArgs {
+    std::string maps_folder = "maps";                                        ///< Folder of map files
+    int max_threads = std::max(1, static_cast<int>(std::thread::hardware_concurrency())); ///< Highest thread count
+    int generated = 8;                                                       ///< Number of generated maps
+    int repeat = 1;                                                          ///< Times every map is played per run
+    unsigned seed = 20240601;                                                ///< Seed of the map generator
+    bool fast_forward = false;                                               ///< Skip repeated cycles of stuck games
+};
+
+/**
+ * @brief A corpus map with its name.
+ */
+struct BenchMap {
+    std::string name;                ///< File name, or a description of a generated map
+    std::unique_ptr<MapData> data;   ///< The parsed or generated map
+};
+
+/**
+ * @brief Measurements of a single game.
+ */
+struct GameSample {
+    double latency_ms = 0;  ///< Wall time of GameManager::run
+    size_t steps = 0;       ///< Rounds played
+};
+
+/**
+ * @brief Player that hands the tank a SimpleBattleInfo built from the satellite view, as HybridTankAlgorithm expects.
+ *        It keeps no state between calls, so its state hash is its configuration.
+ */
+class BenchPlayer : public Player, public StateHashable {
+    size_t rows;        ///< Number of rows of the board
+    size_t cols;        ///< Number of columns of the board
+    int num_shells;     ///< Initial ammo of every tank
+public:
+    BenchPlayer(size_t rows, size_t cols, size_t num_shells) : rows(rows), cols(cols), num_shells(static_cast<int>(num_shells)) {}
+
+    void updateTankWithBattleInfo(TankAlgorithm& tank, SatelliteView& satellite_view) override {
+        SimpleBattleInfo info(satellite_view, rows, cols, num_shells, 0);
+        tank.updateBattleInfo(info);
+    }
+
+    std::uint64_t stateHash() const override {
+        return combineStateHash(combineStateHash(rows, cols), static_cast<std::uint64_t>(num_shells));
+    }
+};
+
+BenchArgs parseBenchArgs(int argc, char* argv[]) {
+    // This function parses key=value arguments, unknown keys are reported and ignored
+    BenchArgs args;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        size_t pos = arg.find('=');
+        std::string key = arg.substr(0, pos);
+        std::string value = pos == std::string::npos ? "" : arg.substr(pos + 1);
+        try {
+            if (key == "maps") args.maps_folder = value;
+            else if (key == "threads") args.max_threads = std::max(1, std::stoi(value));
+            else if (key == "generated") args.generated = std::max(0, std::stoi(value));
+            else if (key == "repeat") args.repeat = std::max(1, std::stoi(value));
+            else if (key == "seed") args.seed = static_cast<unsigned>(std::stoul(value));
+            else if (key == "fast_forward") args.fast_forward = std::stoi(value) != 0;
+            else std::cerr << "Ignoring unsupported argument: " << arg << std::endl;
+        } catch (const std::exception&) {
+            std::cerr << "Ignoring invalid argument: " << arg << std::endl;
+        }
+    }
+    return args;
+}
+
+std::unique_ptr<MapData> generateMap(std::mt19937& random, int size, int tanks_per_player) {
+    // This function generates a square map with random walls and mines and tanks spread over the board
+    std::vector<std::vector<char>> grid(size, std::vector<char>(size, ' '));
+    std::uniform_int_distribution<int> percent(0, 99);
+    for (auto& row : grid) {
+        for (char& cell : row) {
+            int roll = percent(random);
+            cell = roll < 12 ? '#' : (roll < 15 ? '@' : ' ');
+        }
+    }
+    std::uniform_int_distribution<int> coordinate(0, size - 1);
+    for (char player : {'1', '2'}) {
+        for (int placed = 0; placed < tanks_per_player; ) {
+            char& cell = grid[coordinate(random)][coordinate(random)];
+            if (cell == ' ') {
+                cell = player;
+                ++placed;
+            }
+        }
+    }
+    return std::make_unique<MapData>(size * 10, size, size, size, std::move(grid));
+}
+
+std::vector<BenchMap> loadCorpus(const BenchArgs& args) {
+    // This function loads the valid maps of the folder (in name order) and appends the generated maps
+    std::vector<BenchMap> corpus;
+    std::vector<std::string> paths;
+    std::error_code error;
+    for (const auto& entry : std::filesystem::directory_iterator(args.maps_folder, error)) {
+        if (entry.is_regular_file()) {
+            paths.push_back(entry.path().string());
+        }
+    }
+    std::sort(paths.begin(), paths.end());
+    for (const auto& path : paths) {
+        std::vector<std::string> errors;
+        if (auto map = readMapFile(path, errors)) {
+            corpus.push_back(BenchMap{std::filesystem::path(path).filename().string(), std::move(map)});
+        }
+    }
+    std::mt19937 random(args.seed);
+    const int sizes[] = {10, 20, 40, 80};
+    for (int i = 0; i < args.generated; ++i) {
+        int size = sizes[i % 4];
+        int tanks = 1 + (i / 4) % 4;
+        corpus.push_back(BenchMap{"generated_" + std::to_string(size) + "x" + std::to_string(size) + "_" +
+                                  std::to_string(tanks) + "v" + std::to_string(tanks), generateMap(random, size, tanks)});
+    }
+    return corpus;
+}
+
+GameSample playGame(const MapData& map, bool fast_forward) {
+    // This function runs a single game with HybridTankAlgorithm on both sides and measures it
+    const size_t cols = static_cast<size_t>(map.height); // MapData::height holds the columns
+    const size_t rows = static_cast<size_t>(map.length); // MapData::length holds the rows
+    const size_t max_steps = static_cast<size_t>(map.max_steps);
+    const size_t num_shells = static_cast<size_t>(map.num_shells);
+    GameBoardSatelliteView view(&map);
+    BenchPlayer player1(rows, cols, num_shells);
+    BenchPlayer player2(rows, cols, num_shells);
+    TankAlgorithmFactory factory = [](int player_index, int tank_index) -> std::unique_ptr<TankAlgorithm> {
+        return std::make_unique<HybridTankAlgorithm>(player_index, tank_index, kRecalculateInterval, kShellThreatRadius, kAskForInfoInterval);
+    };
+    GameManager_206480972_206899163::GameManager game_manager(false);
+    game_manager.setFastForward(fast_forward);
+    auto start = std::chrono::steady_clock::now();
+    GameResult result = game_manager.run(cols, rows, view, max_steps, num_shells, player1, player2, factory, factory);
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    return GameSample{std::chrono::duration<double, std::milli>(elapsed).count(), result.rounds};
+}
+
+double percentile(std::vector<double> values, double fraction) {
+    // This function returns the nearest-rank percentile of the values
+    if (values.empty()) {
+        return 0;
+    }
+    std::sort(values.begin(), values.end());
+    size_t rank = static_cast<size_t>(fraction * static_cast<double>(values.size()) + 0.999999);
+    return values[std::clamp<size_t>(rank, 1, values.size()) - 1];
+}
+
+long peakRssKb() {
+    // This function returns the peak resident set size of the process so far (kilobytes on Linux)
+    rusage usage{};
+    getrusage(RUSAGE_SELF, &usage);
+    return usage.ru_maxrss;
+}
+
+std::string measureFork(unsigned seed) {
+    // This function times GameBoard::fork on a generated board with shells in flight, and a fork followed by the
+    // first wall hit, which gives the fork its own copy of the terrain, and returns the JSON object of the timings
+    std::mt19937 random(seed);
+    std::unique_ptr<MapData> map = generateMap(random, kForkBoardSize, 4);
+    GameBoardSatelliteView view(map.get());
+    GameBoard board(kForkBoardSize, kForkBoardSize, view, static_cast<size_t>(map->max_steps), static_cast<size_t>(map->num_shells));
+    std::uniform_int_distribution<int> coordinate(0, kForkBoardSize - 1);
+    while (board.getShells().size() < kForkShells) {
+        Point pos(coordinate(random), coordinate(random));
+        if (board.getCharAt(pos) == ' ') {
+            board.addShell(Shell(pos, Direction::R, 0));
+        }
+    }
+    Wall* wall = board.getWalls().front();
+
+    size_t checksum = 0; // keeps the forks from being optimized away
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < kForks; ++i) {
+        checksum += board.fork()->getShells().size();
+    }
+    double fork_us = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count() / kForks;
+    start = std::chrono::steady_clock::now();
+    for (int i = 0; i < kForks; ++i) {
+        std::unique_ptr<GameBoard> copy = board.fork();
+        copy->hitWall(wall);
+        checksum += copy->getWalls().size();
+    }
+    double fork_and_hit_us = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count() / kForks;
+
+    std::ostringstream json;
+    json << std::fixed << std::setprecision(3)
+         << "{\"rows\": " << kForkBoardSize
+         << ", \"cols\": " << kForkBoardSize
+         << ", \"shells\": " << kForkShells
+         << ", \"walls\": " << board.getWalls().size()
+         << ", \"forks\": " << kForks
+         << ", \"fork_us\": " << fork_us
+         << ", \"fork_and_wall_hit_us\": " << fork_and_hit_us
+         << ", \"checksum\": " << checksum << "}";
+    return json.str();
+}
+
+std::string runAtThreads(const std::vector<BenchMap>& corpus, int repeat, int threads, bool fast_forward) {
+    // This function plays the whole corpus on the worker pool and returns the JSON object of the run
+    const size_t games = corpus.size() * static_cast<size_t>(repeat);
+    std::vector<GameSample> samples(games);
+    std::vector<Simulator_206480972_206899163::WorkStealingPool::Task> tasks;
+    tasks.reserve(games);
+    for (size_t i = 0; i < games; ++i) {
+        const MapData& map = *corpus[i % corpus.size()].data;
+        tasks.emplace_back([&samples, &map, i, fast_forward]() { samples[i] = playGame(map, fast_forward); });
+    }
+    Simulator_206480972_206899163::WorkStealingPool pool(static_cast<size_t>(threads), std::move(tasks));
+    auto start = std::chrono::steady_clock::now();
+    pool.run();
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    size_t steps = 0;
+    std::vector<double> latencies;
+    latencies.reserve(games);
+    for (const auto& sample : samples) {
+        steps += sample.steps;
+        latencies.push_back(sample.latency_ms);
+    }
+    std::ostringstream json;
+    json << std::fixed << std::setprecision(3)
+         << "{\"threads\": " << threads
+         << ", \"games\": " << games
+         << ", \"steps\": " << steps
+         << ", \"seconds\": " << seconds
+         << ", \"games_per_sec\": " << (seconds > 0 ? games / seconds : 0)
+         << ", \"steps_per_sec\": " << (seconds > 0 ? steps / seconds : 0)
+         << ", \"p50_ms\": " << percentile(latencies, 0.50)
+         << ", \"p99_ms\": " << percentile(latencies, 0.99)
+         << ", \"peak_rss_kb\": " << peakRssKb() << "}";
+    return json.str();
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    BenchArgs args = parseBenchArgs(argc, argv);
+    std::vector<BenchMap> corpus = loadCorpus(args);
+    if (corpus.empty()) {
+        std::cerr << "No maps to run" << std::endl;
+        return 1;
+    }
+    const std::string fork = measureFork(args.seed);
+    std::vector<std::string> runs;
+    for (int threads = 1; threads <= args.max_threads; ++threads) {
+        runs.push_back(runAtThreads(corpus, args.repeat, threads, args.fast_forward));
+    }
+
+    std::cout << "{\n  \"corpus\": [";
+    for (size_t i = 0; i < corpus.size(); ++i) {
+        std::cout << (i ? ", " : "") << "\"" << corpus[i].name << "\"";
+    }
+    std::cout << "],\n  \"repeat\": " << args.repeat << ",\n  \"fast_forward\": " << (args.fast_forward ? "true" : "false")
+              << ",\n  \"runs\": [\n";
+    for (size_t i = 0; i < runs.size(); ++i) {
+        std::cout << "    " << runs[i] << (i + 1 < runs.size() ? "," : "") << "\n";
+    }
+    std::cout << "  ],\n  \"fork\": " << fork << ",\n  \"peak_rss_kb\": " << peakRssKb() << "\n}" << std::endl;
+    return 0;
+}
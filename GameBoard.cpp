@@ -8,61 +8,93 @@
 #include "GameObject.h"
 #include "Direction.h"
 #include "common/SatelliteView.h"
+#include "UserCommon/BulkSatelliteView.h"
+#include "UserCommon/StateHashable.h"
 #include <algorithm>
 #include <queue>
 #include <cmath>
 #include <vector>
-#include <unordered_map>
 #include <memory>
 
+namespace {
+// Pieces of the Zobrist keys; a shell's piece is kShellPiece plus its direction
+constexpr int kWallPiece = 0;
+constexpr int kDamagedWallPiece = 1;
+constexpr int kMinePiece = 2;
+constexpr int kShellPiece = 3;
+} // namespace
 
 // Constructor from satelliteView
 GameBoard::GameBoard(size_t map_width, size_t map_height, const SatelliteView& map, size_t max_steps, size_t num_shells): rows(static_cast<int>(map_height)), cols(static_cast<int>(map_width)), max_steps(static_cast<int>(max_steps)) {
     objects.clear(); // Initialize empty containers
-    object_at.clear();
+    terrain = std::make_shared<Terrain>();
+    terrain->fixed.assign(map_height * map_width, nullptr);
+    mobiles.assign(map_height * map_width, nullptr);
+    glyphs.assign(map_height * map_width, ' ');
+    words_per_row = (map_width + 63) / 64;
+    terrain->wall_bits.assign(map_height * words_per_row, 0);
+    terrain->damaged_wall_bits.assign(map_height * words_per_row, 0);
+    terrain->mine_bits.assign(map_height * words_per_row, 0);
     player1_tanks.clear();
     player2_tanks.clear();
     int player1_tank_id = 0,  player2_tank_id = 0;     // Track tank IDs for each player
+    // A view that implements BulkSatelliteView hands out all rows at once, any other one is read cell by cell
+    std::vector<char> layout(map_height * map_width);
+    if (const auto* bulk = dynamic_cast<const BulkSatelliteView*>(&map)) {
+        bulk->copyRows(layout.data(), map_width, map_height, map_width);
+    } else {
+        for (size_t y = 0; y < map_height; ++y) {
+            for (size_t x = 0; x < map_width; ++x) {
+                layout[y * map_width + x] = map.getObjectAt(x, y);
+            }
+        }
+    }
+    // The satellite view is indexed (column, row), while board positions are (row, column) like everywhere else in the engine
     for (size_t y = 0; y < map_height; ++y) { // Parse the satellite view and create game objects
         for (size_t x = 0; x < map_width; ++x) {
-            char cell = map.getObjectAt(x, y);
-            Point pos(static_cast<int>(x), static_cast<int>(y));
+            char cell = layout[y * map_width + x];
+            Point pos(static_cast<int>(y), static_cast<int>(x));
             switch (cell) { 
                 case '1': { // Create player 1 tank
-                    auto tank = std::make_unique<Tank>(static_cast<int>(x), static_cast<int>(y), player1_tank_id++, 1, static_cast<int>(num_shells));
+                    auto tank = std::make_unique<Tank>(pos.getX(), pos.getY(), player1_tank_id++, 1, static_cast<int>(num_shells));
                     Tank* tank_ptr = tank.get();
                     player1_tanks.push_back(tank_ptr);
-                    object_at[pos] = tank_ptr;
+                    mobiles[cellIndex(pos)] = tank_ptr;
                     objects.push_back(std::move(tank));
+                    registerObject(tank_ptr);
                     break;
                 }
                 case '2': { // Create player 2 tank
-                    auto tank = std::make_unique<Tank>(static_cast<int>(x), static_cast<int>(y), player2_tank_id++, 2, static_cast<int>(num_shells));
+                    auto tank = std::make_unique<Tank>(pos.getX(), pos.getY(), player2_tank_id++, 2, static_cast<int>(num_shells));
                     Tank* tank_ptr = tank.get();
                     player2_tanks.push_back(tank_ptr);
-                    object_at[pos] = tank_ptr;
+                    mobiles[cellIndex(pos)] = tank_ptr;
                     objects.push_back(std::move(tank));
+                    registerObject(tank_ptr);
                     break;
                 }
                 case '#': { // Create wall 
-                    auto wall = std::make_unique<Wall>(static_cast<int>(x), static_cast<int>(y));
+                    auto wall = std::make_unique<Wall>(pos.getX(), pos.getY());
                     Wall* wall_ptr = wall.get();
-                    object_at[pos] = wall_ptr;
-                    objects.push_back(std::move(wall));
+                    terrain->fixed[cellIndex(pos)] = wall_ptr;
+                    assignBit(terrain->wall_bits, pos, true);
+                    terrain->objects.push_back(std::move(wall));
+                    registerObject(wall_ptr);
                     break;
                 }
                 case '@': { // Create mine
-                    auto mine = std::make_unique<Mine>(static_cast<int>(x), static_cast<int>(y));
+                    auto mine = std::make_unique<Mine>(pos.getX(), pos.getY());
                     Mine* mine_ptr = mine.get();
-                    object_at[pos] = mine_ptr;
-                    objects.push_back(std::move(mine));
+                    terrain->fixed[cellIndex(pos)] = mine_ptr;
+                    assignBit(terrain->mine_bits, pos, true);
+                    terrain->objects.push_back(std::move(mine));
+                    registerObject(mine_ptr);
                     break;
                 }
                 case '*': { // Create shell
-                    auto shell = std::make_unique<Shell>(Point(static_cast<int>(x), static_cast<int>(y)), Direction::U, 0);
-                    Shell* shell_ptr = shell.get();
-                    object_at[pos] = shell_ptr;
-                    objects.push_back(std::move(shell));
+                    Shell* shell_ptr = acquireShell(Shell(pos, Direction::U, 0));
+                    mobiles[cellIndex(pos)] = shell_ptr;
+                    registerObject(shell_ptr);
                     break;
                 }
                 case ' ':
@@ -71,6 +103,12 @@ GameBoard::GameBoard(size_t map_width, size_t map_height, const SatelliteView& m
             }
         }
     }
+    for (int index = 0; index < rows * cols; ++index) {
+        refreshGlyph(index);
+    }
+    // Every object may be removed, so removing one never allocates
+    removed_objects.reserve(objects.size());
+    terrain->removed_objects.reserve(terrain->objects.size());
 }
 
 // Getters
@@ -87,43 +125,54 @@ int GameBoard::getMaxSteps() const {
 }
 
 GameObject* GameBoard::getObjectAt(Point p) const {
-    // This function returns the GameObject at a specific position on the board
+    // This function returns the GameObject at a specific position on the board, a tank or shell above a wall or mine.
     // If no object exists at that position, it returns nullptr.
-    auto it = object_at.find(p);
-    return (it != object_at.end()) ? it->second : nullptr;
+    const int index = cellIndex(p);
+    if (index < 0) {
+        return nullptr;
+    }
+    return mobiles[index] ? mobiles[index] : terrain->fixed[index];
+}
+
+std::span<const char> GameBoard::getCharRow(int row) const {
+    // This function returns a row of the character mirror, rows are stored one after the other
+    return std::span<const char>(glyphs).subspan(static_cast<size_t>(row) * static_cast<size_t>(cols), static_cast<size_t>(cols));
+}
+
+char GameBoard::getCharAt(const Point& p) const {
+    // This function reads the character mirror, a single byte per cell
+    const int index = cellIndex(p);
+    return index < 0 ? ' ' : glyphs[index];
 }
 
 bool GameBoard::isObjectOnBoard(const GameObject* object) const {
-    // This function checks if a GameObject is on the board by checking if its position exists in the object_at map
-    if (!object) return false;
-    for (auto& ptr: objects){
-        if (ptr.get() == object) {
-            return true;
-        }
-    }
-    return false;
+    // This function checks if a GameObject is on the board. The board flags every object it places and clears
+    // the flag when it removes the object, which stays allocated, so the check is a single load.
+    return object && object->isOnBoard();
 }
 
 bool GameBoard::isObjectOnBoard(const Point& point) const {
-    // This function checks if an object exists at a specific position on the board 
-    auto it = object_at.find(point);
-    if (it == object_at.end()) {
-        return false;
-    }
-    const GameObject* obj = it->second;
-    for (const auto& ptr : objects) {
-        if (ptr.get() == obj) {
-            return true;
-        }
-    }
-
-    return false; 
+    // This function checks if an object exists at a specific position on the board.
+    // Removed objects are cleared from their cell, so an occupied cell only holds objects on the board.
+    return getObjectAt(point) != nullptr;
 }
 
 void GameBoard::removeObjectAt(Point p) {
-    // This function removes the GameObject at a specific position on the board
+    // This function clears the cell at a specific position on the board
     // If no object exists at that position, it does nothing.
-    object_at.erase(p);
+    const int index = cellIndex(p);
+    if (index < 0) {
+        return;
+    }
+    mobiles[index] = nullptr;
+    if (terrain->fixed[index]) {
+        Terrain& own = writableTerrain();
+        own.fixed[index] = nullptr;
+        assignBit(own.wall_bits, p, false);
+        assignBit(own.damaged_wall_bits, p, false);
+        assignBit(own.mine_bits, p, false);
+    }
+    refreshGlyph(index);
 }
 
 std::vector<Tank*>& GameBoard::getPlayerTanks(int player_id) {
@@ -133,166 +182,245 @@ std::vector<Tank*>& GameBoard::getPlayerTanks(int player_id) {
 
 void GameBoard::printBoardState() const {
     // This function prints the current state of the game board
-    std::vector<std::vector<char>> board(rows, std::vector<char>(cols, ' '));
-
-    for (const auto& [pos, obj] : object_at) {
-        if(!this->isObjectOnBoard(obj)) {
-            board[pos.getX()][pos.getY()] = ' '; // If the object is not on the board, leave it empty
-        }
-        else {
-            board[pos.getX()][pos.getY()] = obj->toChar();
-        }
-    }
-
     for (int x = 0; x < rows; ++x) {
         for (int y = 0; y < cols; ++y) {
-            std::cout << board[x][y];
+            const GameObject* obj = getObjectAt(Point(x, y));
+            std::cout << (obj ? obj->toChar() : ' ');
         }
         std::cout << '\n';
     }
 }
 
 bool GameBoard::isWallAt(const Point& pos) const {
-    // This function checks if there's a wall object at the given position
-    if (this->isObjectOnBoard(pos) == false) {
-        return false; // No object at the position
-    }
-    auto it = object_at.find(pos);
-    if (it == object_at.end()) {
-        return false;
+    // This function checks the wall bitboard
+    return testBit(terrain->wall_bits, pos);
+}
+
+bool GameBoard::isDamagedWallAt(const Point& pos) const {
+    // This function checks the damaged wall bitboard
+    return testBit(terrain->damaged_wall_bits, pos);
+}
+
+bool GameBoard::isMineAt(const Point& pos) const {
+    // This function checks the mine bitboard
+    return testBit(terrain->mine_bits, pos);
+}
+
+Wall* GameBoard::getWallAt(const Point& pos) const {
+    // This function returns the wall of the cell; only walls and mines go into the fixed slot
+    const int index = cellIndex(pos);
+    if (index < 0 || !terrain->fixed[index] || terrain->fixed[index]->getType() != GameObject::Type::Wall) {
+        return nullptr;
     }
+    return static_cast<Wall*>(terrain->fixed[index]);
+}
 
-    return dynamic_cast<Wall*>(it->second) != nullptr;
+Mine* GameBoard::getMineAt(const Point& pos) const {
+    // This function returns the mine of the cell, if the fixed slot holds one
+    const int index = cellIndex(pos);
+    if (index < 0 || !terrain->fixed[index] || terrain->fixed[index]->getType() != GameObject::Type::Mine) {
+        return nullptr;
+    }
+    return static_cast<Mine*>(terrain->fixed[index]);
 }
 
 void GameBoard::addShell(Shell&& shell) {
-    // This function adds a new Shell to the game board
-    auto shell_ptr = std::make_unique<Shell>(std::move(shell));
-    Point pos = shell_ptr->getPosition();
-    
-    object_at[pos] = shell_ptr.get(); 
-    objects.push_back(std::move(shell_ptr));
+    // This function adds a new Shell to the game board; once the pool is warm this allocates nothing
+    Shell* shell_ptr = acquireShell(std::move(shell));
+    const int index = cellIndex(shell_ptr->getPosition());
+    if (index >= 0) {
+        mobiles[index] = shell_ptr;
+        refreshGlyph(index);
+    }
+    registerObject(shell_ptr);
 }
 
 void GameBoard::removeShell(Shell* shell) {
     // This function removes a shell from the game board
     if (!this->isObjectOnBoard(shell)) return;
     if (!shell) return;
-    Point pos = shell->getPosition();
-    object_at.erase(pos);
-    objects.erase(std::remove_if(objects.begin(), objects.end(),
-            [shell](const std::unique_ptr<GameObject>& obj) {
-                return obj.get() == shell; }),objects.end());
+    const int index = cellIndex(shell->getPosition());
+    if (index >= 0 && mobiles[index] == shell) {
+        mobiles[index] = nullptr;
+        refreshGlyph(index);
+    }
+    retireObject(shell);
 }
 
 
 
-void GameBoard::removeWall(Wall* wall) {
-    // This function removes a wall from the game board
-    if (!this->isObjectOnBoard(wall)) return;
-    if (wall == nullptr) return;
-    object_at.erase(wall->getPosition());
-
-    auto it = std::remove_if(objects.begin(), objects.end(),
-        [wall](const std::unique_ptr<GameObject>& obj) {
-            return obj.get() == wall;
-        });
-
-    if (it != objects.end()) {
-        objects.erase(it, objects.end());
+void GameBoard::hitWall(Wall* wall) {
+    // This function applies a shell hit, the first one damages the wall and the second one destroys it.
+    // The wall is looked up by position, since the pointer may come from a terrain shared with a fork.
+    if (wall == nullptr || getWallAt(wall->getPosition()) == nullptr) return;
+    const Point pos = wall->getPosition();
+    Wall* own = static_cast<Wall*>(writableTerrain().fixed[cellIndex(pos)]);
+    if (own->getHitCount() == 0) {
+        terrain->hash ^= zobristKey(own); // the intact wall's key is swapped for the damaged one
+        own->incrementHitCount();
+        terrain->hash ^= zobristKey(own);
+        assignBit(terrain->damaged_wall_bits, pos, true);
+    } else {
+        removeWall(own);
     }
 }
 
+void GameBoard::removeWall(Wall* wall) {
+    // This function removes a wall from the game board, looking it up by position like hitWall
+    if (wall == nullptr || getWallAt(wall->getPosition()) == nullptr) return;
+    const Point pos = wall->getPosition();
+    Terrain& own = writableTerrain();
+    GameObject* own_wall = own.fixed[cellIndex(pos)];
+    own.fixed[cellIndex(pos)] = nullptr;
+    assignBit(own.wall_bits, pos, false);
+    assignBit(own.damaged_wall_bits, pos, false);
+    refreshGlyph(cellIndex(pos));
+    retireObject(own_wall);
+}
+
 void GameBoard::removeTank(Tank* tank) {
     // This function removes a tank from the game board
     if (!this->isObjectOnBoard(tank)) return;
-    object_at.erase(tank->getPosition());
-    // Now remove from objects (this deletes the Tank)
-    auto it = std::remove_if(objects.begin(), objects.end(),
-        [tank](const std::unique_ptr<GameObject>& obj) {
-            return obj.get() == tank;
-        });
-    if (it != objects.end()) {
-        objects.erase(it, objects.end());
+    const int index = cellIndex(tank->getPosition());
+    if (index >= 0 && mobiles[index] == tank) {
+        mobiles[index] = nullptr;
+        refreshGlyph(index);
     }
+    retireObject(tank);
 }
 
 void GameBoard::removeMine(Mine* mine) {
-    // This function removes a mine from the board
-    if (!this->isObjectOnBoard(mine)) return;
-    if(mine == nullptr) return;
-    object_at.erase(mine->getPosition());
-
-    auto it = std::remove_if(objects.begin(), objects.end(),
-        [mine](const std::unique_ptr<GameObject>& obj) {
-            return obj.get() == mine;
-        });
-
-    if (it != objects.end()) {
-        objects.erase(it, objects.end());
-    }
+    // This function removes a mine from the board, looking it up by position like removeWall
+    if (mine == nullptr || getMineAt(mine->getPosition()) == nullptr) return;
+    const Point pos = mine->getPosition();
+    Terrain& own = writableTerrain();
+    GameObject* own_mine = own.fixed[cellIndex(pos)];
+    own.fixed[cellIndex(pos)] = nullptr;
+    assignBit(own.mine_bits, pos, false);
+    refreshGlyph(cellIndex(pos));
+    retireObject(own_mine);
 }
 
-std::vector<Wall*> GameBoard::getWalls() const {
-    // This function returns a vector of pointers to all Wall objects on the board
-    std::vector<Wall*> result;
-    for (const auto& obj : objects) {
-        if (auto wall = dynamic_cast<Wall*>(obj.get())) {
-            result.push_back(wall);
+void GameBoard::registerObject(GameObject* object) {
+    // This function appends the object to the registry of its type and marks it as on the board
+    object->setOnBoard(true);
+    switch (object->getType()) {
+        case GameObject::Type::Wall:
+            terrain->walls.push_back(static_cast<Wall*>(object));
+            terrain->hash ^= zobristKey(object);
+            break;
+        case GameObject::Type::Mine:
+            terrain->mines.push_back(static_cast<Mine*>(object));
+            terrain->hash ^= zobristKey(object);
+            break;
+        case GameObject::Type::Shell:
+            static_cast<Shell*>(object)->setBoardSlot(shells.size());
+            shells.push_back(static_cast<Shell*>(object));
+            shell_hash ^= zobristKey(object);
+            break;
+        case GameObject::Type::Tank: {
+            Tank* tank = static_cast<Tank*>(object);
+            tanks_on_board.push_back(tank);
+            (tank->getPlayerIndex() == 1 ? player1_tanks_on_board : player2_tanks_on_board).push_back(tank);
+            break;
         }
     }
-    return result;
 }
-std::vector<Mine*> GameBoard::getMines() const {
-    // This function returns a vector of pointers to all Mine objects on the board
-    std::vector<Mine*> result;
-    for (const auto& obj : objects) {
-        if (auto mine = dynamic_cast<Mine*>(obj.get())) {
-            result.push_back(mine);
+
+namespace {
+template <typename T>
+void eraseFromRegistry(std::vector<T*>& registry, const GameObject* object) {
+    // This function removes the object from a registry, keeping the order of the others
+    auto it = std::find(registry.begin(), registry.end(), object);
+    if (it != registry.end()) {
+        registry.erase(it);
     }
 }
-    return result;
+} // namespace
+
+Shell* GameBoard::acquireShell(Shell&& shell) {
+    // This function reuses a free pooled shell, the pool only grows while more shells fly than ever before
+    if (free_shells.empty()) {
+        shell_pool.push_back(std::move(shell));
+        free_shells.reserve(shell_pool.size()); // so a shell is given back without allocating
+        return &shell_pool.back();
+    }
+    Shell* pooled = free_shells.back();
+    free_shells.pop_back();
+    *pooled = std::move(shell);
+    return pooled;
 }
 
-std::vector<Shell*> GameBoard::getShells() const {
-    // This function returns a vector of pointers to all Shell objects on the board
-    std::vector<Shell*> result;
-     for (const auto& obj : objects) {
-        if (auto shell = dynamic_cast<Shell*>(obj.get())) {
-            result.push_back(shell);
-        }
+void GameBoard::retireObject(GameObject* object) {
+    // This function takes an object off the board without destroying it: the game manager still holds
+    // pointers to removed tanks, and a freed address could be reused by a new object
+    if (object->getType() == GameObject::Type::Shell) {
+        // shells are unordered, so the last one takes the removed shell's slot and the pool gets it back
+        Shell* shell = static_cast<Shell*>(object);
+        Shell* last = shells.back();
+        shells[shell->getBoardSlot()] = last;
+        last->setBoardSlot(shell->getBoardSlot());
+        shells.pop_back();
+        shell_hash ^= zobristKey(shell);
+        shell->setOnBoard(false);
+        free_shells.push_back(shell);
+        return;
     }
-    return result;
+    const bool is_terrain = object->getType() == GameObject::Type::Wall || object->getType() == GameObject::Type::Mine;
+    auto& owner = is_terrain ? terrain->objects : objects;
+    auto& graveyard = is_terrain ? terrain->removed_objects : removed_objects;
+    auto it = std::find_if(owner.begin(), owner.end(),
+        [object](const std::unique_ptr<GameObject>& obj) {
+            return obj.get() == object;
+        });
+    if (it == owner.end()) {
+        return;
+    }
+    switch (object->getType()) {
+        case GameObject::Type::Wall:
+            eraseFromRegistry(terrain->walls, object);
+            terrain->hash ^= zobristKey(object);
+            break;
+        case GameObject::Type::Mine:
+            eraseFromRegistry(terrain->mines, object);
+            terrain->hash ^= zobristKey(object);
+            break;
+        case GameObject::Type::Shell:
+            break;
+        case GameObject::Type::Tank:
+            eraseFromRegistry(tanks_on_board, object);
+            eraseFromRegistry(player1_tanks_on_board, object);
+            eraseFromRegistry(player2_tanks_on_board, object);
+            break;
+    }
+    (*it)->setOnBoard(false);
+    graveyard.push_back(std::move(*it));
+    owner.erase(it);
 }
 
-std::vector<Tank*> GameBoard::getTanksPlayer(int player_index) const {
-    // This function returns a vector of pointers to all tanks belonging to the specified player
-    std::vector<Tank*> result;
-    for (const auto& obj : objects) {
-        if (!this->isObjectOnBoard(obj.get())) {continue;}
-        if (auto tank = dynamic_cast<Tank*>(obj.get())) {
-            // Skip dead tanks
-            if (!this->isObjectOnBoard(tank)) {continue;}
-                if (tank->getPlayerIndex() == player_index) {
-                    result.push_back(tank);
-            }
-        }
-    }
-    return result;
+std::span<Wall* const> GameBoard::getWalls() const {
+    // This function returns the walls on the board
+    return terrain->walls;
 }
 
-std::vector<Tank*> GameBoard::getAllTanks() const {
-    // This function returns a vector of pointers to all tanks on the board
-    std::vector<Tank*> all_tanks;
-    for (const auto& obj : objects) {
-        if (!this->isObjectOnBoard(obj.get())) {continue;}
-        if (auto tank = dynamic_cast<Tank*>(obj.get())) {
-            if (this->isObjectOnBoard(tank)) {
-                all_tanks.push_back(tank);
-            }
-        }
-    }
-    return all_tanks;
+std::span<Mine* const> GameBoard::getMines() const {
+    // This function returns the mines on the board
+    return terrain->mines;
+}
+
+std::span<Shell* const> GameBoard::getShells() const {
+    // This function returns the shells on the board
+    return shells;
+}
+
+std::span<Tank* const> GameBoard::getTanksPlayer(int player_index) const {
+    // This function returns the tanks of the specified player on the board
+    return player_index == 1 ? player1_tanks_on_board : player2_tanks_on_board;
+}
+
+std::span<Tank* const> GameBoard::getAllTanks() const {
+    // This function returns the tanks of both players on the board
+    return tanks_on_board;
 }
 
 int GameBoard::getTankPlayerId(const Tank* tank) const {
@@ -306,17 +434,174 @@ int GameBoard::getTankPlayerId(const Tank* tank) const {
     return 0;
 }
 
-void GameBoard::updateAllObjectsMap() {
-    // This function updates the object_at map to reflect the current state of all objects on the board
-    object_at.clear();
-    for (const auto& obj_ptr : objects) {
-        if (!this->isObjectOnBoard(obj_ptr.get())) {
-            continue;
+void GameBoard::moveObject(GameObject* object, const Point& from) {
+    // This function moves a tank or shell to its new cell. The old cell is only cleared if it still holds
+    // the object, since another tank or shell may have entered it in the meantime.
+    const int old_index = cellIndex(from);
+    if (old_index >= 0 && mobiles[old_index] == object) {
+        mobiles[old_index] = nullptr;
+        refreshGlyph(old_index);
+    }
+    const int new_index = cellIndex(object->getPosition());
+    if (new_index >= 0) {
+        mobiles[new_index] = object;
+        glyphs[new_index] = object->toChar();
+    }
+    if (object->getType() == GameObject::Type::Shell) {
+        const int piece = kShellPiece + static_cast<int>(static_cast<const Shell*>(object)->getDirection());
+        shell_hash ^= zobristKey(from, piece) ^ zobristKey(object);
+    }
+}
+
+std::uint64_t GameBoard::stateHash() const {
+    // This function adds the tanks, which change outside the board, to the Zobrist hashes of the other objects.
+    // XOR keeps the hash independent of the order of the registries.
+    std::uint64_t hash = terrain->hash ^ shell_hash;
+    for (const Tank* tank : tanks_on_board) {
+        std::uint64_t key = combineStateHash(static_cast<std::uint64_t>(tank->getPlayerIndex()), static_cast<std::uint64_t>(tank->getId()));
+        key = combineStateHash(key, static_cast<std::uint64_t>(tank->getPosition().getX()));
+        key = combineStateHash(key, static_cast<std::uint64_t>(tank->getPosition().getY()));
+        key = combineStateHash(key, static_cast<std::uint64_t>(tank->getCanonDir()));
+        key = combineStateHash(key, static_cast<std::uint64_t>(tank->getShootingCooldown()));
+        key = combineStateHash(key, static_cast<std::uint64_t>(tank->getBackwardSteps()));
+        key = combineStateHash(key, static_cast<std::uint64_t>(tank->getAmmoCount()));
+        hash ^= key;
+    }
+    return hash;
+}
+
+std::uint64_t GameBoard::zobristKey(const GameObject* object) {
+    // This function picks the piece of the object from its type and state
+    switch (object->getType()) {
+        case GameObject::Type::Wall:
+            return zobristKey(object->getPosition(), static_cast<const Wall*>(object)->getHitCount() > 0 ? kDamagedWallPiece : kWallPiece);
+        case GameObject::Type::Mine:
+            return zobristKey(object->getPosition(), kMinePiece);
+        case GameObject::Type::Shell:
+            return zobristKey(object->getPosition(), kShellPiece + static_cast<int>(static_cast<const Shell*>(object)->getDirection()));
+        case GameObject::Type::Tank:
+            break;
+    }
+    return 0;
+}
+
+std::uint64_t GameBoard::zobristKey(const Point& p, int piece) {
+    // This function derives the key from the cell and piece instead of reading a table of random keys,
+    // so boards of any size and their forks need no table and always agree on the keys
+    std::uint64_t key = combineStateHash(static_cast<std::uint64_t>(piece), static_cast<std::uint64_t>(p.getX()));
+    return combineStateHash(key, static_cast<std::uint64_t>(p.getY()));
+}
+
+int GameBoard::cellIndex(const Point& p) const {
+    // This function returns the index of the cell of a position, -1 outside the board
+    if (p.getX() < 0 || p.getX() >= rows || p.getY() < 0 || p.getY() >= cols) {
+        return -1;
+    }
+    return p.getX() * cols + p.getY();
+}
+
+void GameBoard::refreshGlyph(int index) {
+    // This function shows the tank or shell of the cell above its wall or mine, like getObjectAt
+    const GameObject* object = mobiles[index] ? mobiles[index] : terrain->fixed[index];
+    glyphs[index] = object ? object->toChar() : ' ';
+}
+
+GameBoard::Terrain& GameBoard::writableTerrain() {
+    // This function gives the board its own terrain before a change; the forks keep the one they shared.
+    // Only walls and mines still on the board are copied, nothing in the copy refers to the removed ones.
+    if (terrain.use_count() > 1) {
+        auto copy = std::make_shared<Terrain>();
+        copy->fixed.assign(terrain->fixed.size(), nullptr);
+        copy->objects.reserve(terrain->objects.size());
+        copy->removed_objects.reserve(terrain->objects.size());
+        for (const auto& object : terrain->objects) {
+            std::unique_ptr<GameObject> own;
+            if (object->getType() == GameObject::Type::Wall) {
+                own = std::make_unique<Wall>(static_cast<const Wall&>(*object));
+            } else {
+                own = std::make_unique<Mine>(static_cast<const Mine&>(*object));
+            }
+            copy->fixed[cellIndex(own->getPosition())] = own.get();
+            copy->objects.push_back(std::move(own));
+        }
+        // the registries keep their order, each wall and mine is the one in its cell
+        for (Wall* wall : terrain->walls) {
+            copy->walls.push_back(static_cast<Wall*>(copy->fixed[cellIndex(wall->getPosition())]));
+        }
+        for (Mine* mine : terrain->mines) {
+            copy->mines.push_back(static_cast<Mine*>(copy->fixed[cellIndex(mine->getPosition())]));
+        }
+        copy->wall_bits = terrain->wall_bits;
+        copy->damaged_wall_bits = terrain->damaged_wall_bits;
+        copy->mine_bits = terrain->mine_bits;
+        copy->hash = terrain->hash;
+        terrain = std::move(copy);
+    }
+    return *terrain;
+}
+
+std::unique_ptr<GameBoard> GameBoard::fork() const {
+    // This function copies the tanks, shells and their cell slots, and shares the terrain
+    auto copy = std::make_unique<GameBoard>();
+    copy->rows = rows;
+    copy->cols = cols;
+    copy->max_steps = max_steps;
+    copy->terrain = terrain;
+    copy->words_per_row = words_per_row;
+    copy->mobiles.assign(mobiles.size(), nullptr);
+    copy->glyphs = glyphs;
+    // Every tank is copied, removed ones too, so getPlayerTanks of the copy lines up with this board
+    copy->objects.reserve(player1_tanks.size() + player2_tanks.size());
+    copy->removed_objects.reserve(player1_tanks.size() + player2_tanks.size());
+    for (int player_index = 1; player_index <= 2; ++player_index) {
+        const std::vector<Tank*>& from = player_index == 1 ? player1_tanks : player2_tanks;
+        std::vector<Tank*>& to = player_index == 1 ? copy->player1_tanks : copy->player2_tanks;
+        for (const Tank* tank : from) {
+            auto own = std::make_unique<Tank>(*tank);
+            to.push_back(own.get());
+            (tank->isOnBoard() ? copy->objects : copy->removed_objects).push_back(std::move(own));
+        }
+    }
+    auto ownTank = [this, &copy](const Tank* tank) {
+        const std::vector<Tank*>& from = tank->getPlayerIndex() == 1 ? player1_tanks : player2_tanks;
+        const std::vector<Tank*>& to = tank->getPlayerIndex() == 1 ? copy->player1_tanks : copy->player2_tanks;
+        return to[std::find(from.begin(), from.end(), tank) - from.begin()];
+    };
+    for (const Tank* tank : tanks_on_board) {
+        Tank* own = ownTank(tank);
+        copy->tanks_on_board.push_back(own);
+        (own->getPlayerIndex() == 1 ? copy->player1_tanks_on_board : copy->player2_tanks_on_board).push_back(own);
+        const int index = cellIndex(tank->getPosition());
+        if (index >= 0 && mobiles[index] == tank) {
+            copy->mobiles[index] = own;
         }
-        if (obj_ptr) {
-            object_at[obj_ptr->getPosition()] = obj_ptr.get();
+    }
+    for (const Shell* shell : shells) {
+        Shell* own = copy->acquireShell(Shell(*shell));
+        copy->registerObject(own);
+        const int index = cellIndex(shell->getPosition());
+        if (index >= 0 && mobiles[index] == shell) {
+            copy->mobiles[index] = own;
         }
     }
+    return copy;
 }
 
+bool GameBoard::testBit(const std::vector<std::uint64_t>& bits, const Point& p) const {
+    // This function reads the bit of a position, false outside the board
+    if (p.getX() < 0 || p.getX() >= rows || p.getY() < 0 || p.getY() >= cols) {
+        return false;
+    }
+    const size_t word = static_cast<size_t>(p.getX()) * words_per_row + static_cast<size_t>(p.getY()) / 64;
+    return (bits[word] >> (p.getY() % 64)) & 1u;
+}
 
+void GameBoard::assignBit(std::vector<std::uint64_t>& bits, const Point& p, bool value) {
+    // This function writes the bit of a position, positions outside the board are ignored
+    if (p.getX() < 0 || p.getX() >= rows || p.getY() < 0 || p.getY() >= cols) {
+        return;
+    }
+    const size_t word = static_cast<size_t>(p.getX()) * words_per_row + static_cast<size_t>(p.getY()) / 64;
+    const std::uint64_t mask = std::uint64_t{1} << (p.getY() % 64);
+    bits[word] = value ? (bits[word] | mask) : (bits[word] & ~mask);
+}
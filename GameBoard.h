@@ -2,9 +2,11 @@
 #define GAMEBOARD_H
 
 #include <vector>
+#include <deque>
 #include <memory>
-#include <unordered_map>
+#include <span>
 #include <cstddef> // for size_t
+#include <cstdint>
 #include "common/SatelliteView.h"
 #include "Point.h"
 #include "GameObject.h"
@@ -20,10 +22,39 @@ private:
     int rows;  ///< Number of rows on the board
     int cols;  ///< Number of columns on the board
     int max_steps; ///< Maximum number of steps in the game
-    std::vector<std::unique_ptr<GameObject>> objects; ///< All game objects owned by the board
-    std::unordered_map<Point, GameObject*> object_at; ///< Maps positions to game objects
+    std::vector<std::unique_ptr<GameObject>> objects; ///< Tanks owned by the board; walls and mines live in terrain, shells in shell_pool
+    std::vector<std::unique_ptr<GameObject>> removed_objects; ///< Tanks taken off the board, kept alive until the board is destroyed
+    std::deque<Shell> shell_pool;     ///< Every shell the board created; a deque never moves its elements
+    std::vector<Shell*> free_shells;  ///< Pooled shells taken off the board, reused by the next shots
+    /**
+     * @brief Walls and mines with their cell slots and bitboards. They never move, so a board and its forks
+     *        share one Terrain until one of them hits or removes a wall or mine and takes its own copy.
+     */
+    struct Terrain {
+        std::vector<std::unique_ptr<GameObject>> objects;         ///< Walls and mines on the board
+        std::vector<std::unique_ptr<GameObject>> removed_objects; ///< Walls and mines taken off the board, kept alive with the terrain
+        std::vector<GameObject*> fixed; ///< Wall or mine of each cell, indexed by row * cols + column
+        std::vector<Wall*> walls;       ///< Walls on the board, in placement order
+        std::vector<Mine*> mines;       ///< Mines on the board, in placement order
+        // Bitboards: one bit per cell, bit (column % 64) of word (row * words_per_row + column / 64),
+        // so every row starts on a word boundary. Kept in step with fixed on every place, hit and remove.
+        std::vector<std::uint64_t> wall_bits;         ///< Cells holding a wall
+        std::vector<std::uint64_t> damaged_wall_bits; ///< Cells holding a wall that was already hit once
+        std::vector<std::uint64_t> mine_bits;         ///< Cells holding a mine
+        std::uint64_t hash = 0;                       ///< Zobrist hash of the walls, with their damage, and the mines
+    };
+    std::shared_ptr<Terrain> terrain;  ///< Walls and mines, possibly shared with forks of this board
+    size_t words_per_row = 0;          ///< Words per bitboard row, (cols + 63) / 64
+    std::vector<GameObject*> mobiles;  ///< Tank or shell of each cell, indexed like fixed and shown above it
+    std::vector<char> glyphs;          ///< Character of each cell as a satellite view shows it, kept in step with mobiles and fixed
+    std::uint64_t shell_hash = 0;      ///< Zobrist hash of the shells on the board, updated on every add, move and remove
     std::vector<Tank*> player1_tanks; ///< Pointers to player 1's tanks
     std::vector<Tank*> player2_tanks; ///< Pointers to player 2's tanks
+    // Tanks and shells on the board by type, updated on every add and remove
+    std::vector<Shell*> shells;              ///< Shells on the board, unordered (removal swaps in the last shell)
+    std::vector<Tank*> tanks_on_board;       ///< Tanks of both players on the board, in placement order
+    std::vector<Tank*> player1_tanks_on_board; ///< Player 1's tanks on the board
+    std::vector<Tank*> player2_tanks_on_board; ///< Player 2's tanks on the board
 
 public:
     GameBoard() = default; // Default constructor
@@ -60,6 +91,20 @@ public:
      */
     GameObject* getObjectAt(Point p) const;
 
+    /**
+     * @brief Returns the character of the object getObjectAt returns ('1', '2', '*', '#', '@'), or ' ' for an empty cell.
+     *        Read from a character mirror of the board that is updated on every add, move and remove.
+     * @param p The position to query; positions outside the board read ' '.
+     */
+    char getCharAt(const Point& p) const;
+
+    /**
+     * @brief Returns the character mirror of a whole row, cols characters as getCharAt returns them.
+     *        The view is invalidated by the next change to the board.
+     * @param row The row, 0 <= row < rows.
+     */
+    std::span<const char> getCharRow(int row) const;
+
     /**
      * @brief Returns a reference to the vector of tanks for the specified player.
      * @param player_id The player ID (1 or 2).
@@ -67,11 +112,23 @@ public:
     std::vector<Tank*>& getPlayerTanks(int player_id);
 
     /**
-     * @brief Checks if there is a wall at the given position.
+     * @brief Checks if there is a wall at the given position, a single bit test.
      * @param pos The position to check.
      */
     bool isWallAt(const Point& pos) const;
 
+    /**
+     * @brief Checks if there is a wall at the given position that was already hit once.
+     * @param pos The position to check.
+     */
+    bool isDamagedWallAt(const Point& pos) const;
+
+    /**
+     * @brief Checks if there is a mine at the given position, a single bit test.
+     * @param pos The position to check.
+     */
+    bool isMineAt(const Point& pos) const;
+
     /**
      * @brief Removes the object at the given position from the board.
      * @param p The position to remove the object from.
@@ -84,30 +141,47 @@ public:
     void printBoardState() const;
 
     /**
-     * @brief Returns a vector of pointers to all Shell objects on the board.
+     * @brief Returns the wall at the given position, or nullptr if there is none.
+     * @param pos The position to check.
+     */
+    Wall* getWallAt(const Point& pos) const;
+
+    /**
+     * @brief Returns the mine at the given position, or nullptr if there is none.
+     * @param pos The position to check.
+     */
+    Mine* getMineAt(const Point& pos) const;
+
+    /**
+     * @brief Returns all Shell objects on the board, in no particular order.
+     *        The view is invalidated by the next add or remove.
      */
-    std::vector<Shell*> getShells() const;
+    std::span<Shell* const> getShells() const;
 
     /**
-     * @brief Returns a vector of pointers to all Wall objects on the board.
+     * @brief Returns all Wall objects on the board, in placement order.
+     *        The view is invalidated by the next remove.
      */
-    std::vector<Wall*> getWalls() const;
+    std::span<Wall* const> getWalls() const;
 
     /**
-     * @brief Returns a vector of pointers to all Mine objects on the board.
+     * @brief Returns all Mine objects on the board, in placement order.
+     *        The view is invalidated by the next remove.
      */
-    std::vector<Mine*> getMines() const;
+    std::span<Mine* const> getMines() const;
 
     /**
-     * @brief Returns a vector of pointers to all tanks belonging to the specified player.
+     * @brief Returns all tanks of the specified player on the board, in placement order.
+     *        The view is invalidated by the next remove.
      * @param player_index The player index (1 or 2).
      */
-    std::vector<Tank*> getTanksPlayer(int player_index) const;
+    std::span<Tank* const> getTanksPlayer(int player_index) const;
 
     /**
-     * @brief Returns a vector of pointers to all tanks on the board.
+     * @brief Returns all tanks on the board, in placement order.
+     *        The view is invalidated by the next remove.
      */
-    std::vector <Tank*> getAllTanks() const;
+    std::span<Tank* const> getAllTanks() const;
 
     /**
      * @brief Returns the player ID (1 or 2) for the given tank pointer, or 0 if not found.
@@ -128,11 +202,18 @@ public:
     bool isObjectOnBoard(const Point& pos) const;
 
     /**
-     * @brief Adds a new Shell to the board.
+     * @brief Adds a new Shell to the board, reusing a pooled shell when one is free.
+     *        A removed shell's address may be reused, so shell pointers must not be kept across this call.
      * @param shell The Shell object to add (moved).
      */
     void addShell(Shell&& shell);
 
+    /**
+     * @brief Applies a shell hit to a wall: an intact wall is damaged, a damaged wall is removed.
+     * @param wall Pointer to the Wall that was hit. Walls no longer on the board are ignored.
+     */
+    void hitWall(Wall* wall);
+
     /**
      * @brief Removes the specified Wall from the board.
      * @param wall Pointer to the Wall to remove.
@@ -158,11 +239,98 @@ public:
     void removeMine(Mine* mine);
 
     /**
-     * @brief Updates the object_at map for all objects on the board.
-     *        Rebuilds the mapping from scratch based on current object positions.
+     * @brief Creates an independent copy of the board, for look-ahead and replay.
+     *        Tanks and shells are copied, while walls and mines are shared until either board hits or removes one,
+     *        so forking costs about a pass over the cells, not a deep copy. A snapshot is a fork that is left untouched.
+     *        The copy's tanks are at the same indices of getPlayerTanks as the originals.
+     *        A board and its forks may be used from different threads, but a board must not change while it is forked.
+     * @return The new board.
+     */
+    std::unique_ptr<GameBoard> fork() const;
+
+    /**
+     * @brief Returns a hash of the game state on the board: every tank on it with its position, direction, cooldown,
+     *        backward counter and ammo, every shell with its position and direction, every wall with its damage and every mine.
+     *        Walls, mines and shells are kept as Zobrist hashes updated on every change; the tanks, which the game manager
+     *        changes directly, are folded in on each call, O(tanks). Equal boards hash equally, also across forks.
      */
-    void updateAllObjectsMap();
+    std::uint64_t stateHash() const;
 
+    /**
+     * @brief Updates the cell index after a tank or shell moved.
+     * @param object The tank or shell, already at its new position.
+     * @param from The position it moved from.
+     */
+    void moveObject(GameObject* object, const Point& from);
+
+private:
+    /**
+     * @brief Returns the index of the cell at the given position, or -1 if the position is outside the board.
+     * @param p The position.
+     */
+    int cellIndex(const Point& p) const;
+
+    /**
+     * @brief Recomputes the character mirror of a cell after its tank, shell, wall or mine changed.
+     * @param index The index of the cell.
+     */
+    void refreshGlyph(int index);
+
+    /**
+     * @brief Returns the terrain for a change, first replacing a terrain shared with forks by a private copy.
+     *        Wall and mine pointers taken before the call may point into the old terrain, so callers pass
+     *        them on by position.
+     */
+    Terrain& writableTerrain();
+
+    /**
+     * @brief Returns the bit of a position in a terrain bitboard, false outside the board.
+     * @param bits The bitboard.
+     * @param p The position.
+     */
+    bool testBit(const std::vector<std::uint64_t>& bits, const Point& p) const;
+
+    /**
+     * @brief Sets or clears the bit of a position in a terrain bitboard; positions outside the board are ignored.
+     * @param bits The bitboard.
+     * @param p The position.
+     * @param value The new value of the bit.
+     */
+    void assignBit(std::vector<std::uint64_t>& bits, const Point& p, bool value);
+
+    /**
+     * @brief Returns the Zobrist key of a wall, mine or shell in its current cell and state, 0 for a tank.
+     * @param object The object.
+     */
+    static std::uint64_t zobristKey(const GameObject* object);
+
+    /**
+     * @brief Returns the Zobrist key of a piece in a cell.
+     * @param p The position of the cell.
+     * @param piece The piece: a damaged or intact wall, a mine, or a shell moving in a given direction.
+     */
+    static std::uint64_t zobristKey(const Point& p, int piece);
+
+    /**
+     * @brief Adds an object to the registry of its type.
+     * @param object Pointer to the object, already owned by objects, terrain or shell_pool.
+     */
+    void registerObject(GameObject* object);
+
+    /**
+     * @brief Takes a shell from the free list, or grows the pool, and moves the given shell into it.
+     * @param shell The shell to store (moved).
+     * @return Pointer to the pooled shell, not yet registered.
+     */
+    Shell* acquireShell(Shell&& shell);
+
+    /**
+     * @brief Takes an object off the board. A shell is swapped out of the shell list and returned to the pool;
+     *        a tank moves from objects and its registries to removed_objects, and a wall or mine does the same
+     *        within the terrain, so pointers to it stay valid.
+     * @param object Pointer to the object to retire.
+     */
+    void retireObject(GameObject* object);
 };
 
 
@@ -1,6 +1,8 @@
 #include "GameBoardSatelliteView.h"
 #include "GameBoard.h"
+#include <algorithm>
 #include <cstddef>
+#include <cstring>
 #include <iostream> // Include iostream for debug output
 
 // Constructor: initializes the satellite view with a reference to the board and the player's tank
@@ -8,46 +10,53 @@ GameBoardSatelliteView::GameBoardSatelliteView(GameBoard* board, Tank* selfTank)
     : board(board), selfTank(selfTank) {}
 
 
-GameBoardSatelliteView::GameBoardSatelliteView(const MapData* map) : map_view(map->grid){
-}
+// Constructor: initializes the satellite view over a parsed map (no board)
+GameBoardSatelliteView::GameBoardSatelliteView(const MapData* map) : map(map) {}
 
 // Returns a character representing the object at (x, y)
 char GameBoardSatelliteView::getObjectAt(size_t x, size_t y) const { 
+    if (map) { // Initial state: x is the column and y is the row of the parsed grid
+        if (x >= static_cast<size_t>(map->height) || y >= static_cast<size_t>(map->length)) {
+            return '&';
+        }
+        return map->grid[y][x];
+    }
     int cols = board->getCols();
     int rows = board->getRows();
     if (x >= static_cast<size_t>(rows) || y >= static_cast<size_t>(cols)) { // Out of bounds check
         return '&';
     } 
-    if (board->isObjectOnBoard(Point(x, y)) == false) { // No object at this position
-        return ' ';
-    }
     Point p(static_cast<int>(x), static_cast<int>(y));
-    GameObject* obj = board->getObjectAt(p);
-    
-    if (!obj || obj == nullptr) { // If no object found, return space
-        return ' '; 
-    }
-    if (obj == selfTank) { // If the object is the player's own tank
+    // The board keeps the character of every cell, only the player's own tank is drawn differently
+    if (selfTank && selfTank->getPosition() == p && board->getObjectAt(p) == selfTank) {
         return '%';
     }
-    if (dynamic_cast<const Wall*>(obj)) {  // If the object is a wall
-        return '#';
-    }
-    if (dynamic_cast<const Shell*>(obj)) { // If the object is a shell
-        return '*';
+    return board->getCharAt(p);
+}
+
+void GameBoardSatelliteView::copyRows(char* dst, size_t stride, size_t rows, size_t cols) const {
+    // Copies each row in one go, the part of the window outside the board is filled with '&'
+    const size_t view_rows = map ? static_cast<size_t>(map->length) : static_cast<size_t>(board->getRows());
+    const size_t view_cols = map ? static_cast<size_t>(map->height) : static_cast<size_t>(board->getCols());
+    for (size_t r = 0; r < rows; ++r) {
+        char* row = dst + r * stride;
+        size_t copied = 0;
+        if (r < view_rows) {
+            copied = std::min(cols, view_cols);
+            const char* source = map ? map->grid[r].data() : board->getCharRow(static_cast<int>(r)).data();
+            std::memcpy(row, source, copied);
+        }
+        std::memset(row + copied, '&', cols - copied);
     }
-    if (dynamic_cast<const Mine*>(obj)) { // If the object is a mine
-        return '@';
+    if (map || !selfTank) {
+        return;
     }
-    if (const Tank* tank = dynamic_cast<const Tank*>(obj)) { // If the object is a tank (not self)
-
-        return (tank->getPlayerIndex() == 1) ? '1' : '2';
+    const Point self = selfTank->getPosition(); // x is the row, y the column
+    if (board->getObjectAt(self) == selfTank && static_cast<size_t>(self.getX()) < rows && static_cast<size_t>(self.getY()) < cols) {
+        dst[static_cast<size_t>(self.getX()) * stride + static_cast<size_t>(self.getY())] = '%';
     }
-    // Default: empty space
-    return ' ';
 }
 
-
 void GameBoardSatelliteView::printView() const {
     // Prints the satellite view of the board - used for debugging
     int cols = board->getCols();
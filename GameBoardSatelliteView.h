@@ -1,4 +1,5 @@
 #include "common/SatelliteView.h"
+#include "UserCommon/BulkSatelliteView.h"
 #include "GameBoard.h"
 #include "UserCommon/MapData.h"
 #include "Tank.h"
@@ -9,7 +10,7 @@
  * @brief Provides a satellite view of the game board for a specific tank.
  *        Allows querying the board state and printing a debug view.
  */
-class GameBoardSatelliteView : public SatelliteView {
+class GameBoardSatelliteView : public SatelliteView, public BulkSatelliteView {
 public:
     /**
      * @brief Constructs a satellite view for the given board and tank.
@@ -19,6 +20,11 @@ public:
     GameBoardSatelliteView(GameBoard* board, Tank* selfTank);
 
 
+    /**
+     * @brief Constructs a read-only view over a parsed map, used as the initial state given to a GameManager.
+     *        The view does not copy the map, the map must outlive it.
+     * @param map Pointer to the parsed map.
+     */
     GameBoardSatelliteView(const MapData* map);
 
 
@@ -30,16 +36,22 @@ public:
      */
     char getObjectAt(size_t x, size_t y) const override;
 
+    /**
+     * @brief Copies whole rows of the board or map, see BulkSatelliteView::copyRows.
+     *        Board rows come from the board's character mirror, map rows from the parsed grid.
+     */
+    void copyRows(char* dst, size_t stride, size_t rows, size_t cols) const override;
+
     /**
      * @brief Prints a debug view of the board to stdout.
      */
     void printView() const; // For debugging purposes
 
 private:
-    GameBoard* board;   ///< pointer to the game board
-    Tank* selfTank;     ///< Pointer to the player's own tank
+    GameBoard* board = nullptr;   ///< pointer to the game board
+    Tank* selfTank = nullptr;     ///< Pointer to the player's own tank
 
     //for initialization for GameManager
-    std::vector<std::vector<char>> map_view; ///< 2D vector to hold the view of the board
+    const MapData* map = nullptr; ///< Parsed map viewed instead of a board, shared and never copied
 
 };
@@ -6,9 +6,11 @@
 #include "common/SatelliteView.h"
 #include "common/TankAlgorithm.h"
 #include "GameBoardSatelliteView.h"
+#include "UserCommon/StateHashable.h"
 #include <memory>
+#include <span>
 #include <vector>
-#include <list>
+#include <tuple>
 #include <iostream>
 #include <algorithm>
 // TODO:think where should combine verbose and create logger corresponding to verbose
@@ -16,16 +18,18 @@ namespace GameManager_206480972_206899163 {
     GameResult GameManager::run( size_t map_width, size_t map_height, const SatelliteView& map, size_t max_steps, size_t num_shells, Player& player1, Player& player2,
         TankAlgorithmFactory player1_tank_algo_factory, TankAlgorithmFactory player2_tank_algo_factory) {
         //This function runs the game loop, processing each step until the game is over.
-        std::unique_ptr <GameBoard> board = std::make_unique<GameBoard>(map_width, map_height, map, num_shells, max_steps); // converting SatelliteView to GameBoard
+        board = std::make_unique<GameBoard>(map_width, map_height, map, num_shells, max_steps); // converting SatelliteView to GameBoard
         resetGameState();
         players.push_back(&player1);
         players.push_back(&player2);
         const std::vector<Tank*>& p1_tanks = board->getPlayerTanks(1);
         const std::vector<Tank*>& p2_tanks = board->getPlayerTanks(2);
         initAllTanksSorted(player1_tank_algo_factory, player2_tank_algo_factory);
+        reserveRemovalBuffers();
         if (checkImmediateEnd(p1_tanks, p2_tanks)) { // Check if the game can end immediately
             return buildImmediateResult(p1_tanks, p2_tanks);
         }
+        startFastForward();
         GameResult result = runGameLoop(); // Run the game loop until the game is over
 
         return result;
@@ -65,24 +69,18 @@ void GameManager::resetGameState() {
     game_over = false;
 }
 
-std::vector<std::pair<TankData*, ActionRequest>> GameManager::gatherRequests()
- {
-    // This function gathers action requests from all tanks and stores them in a vector.
-    std::vector<std::pair<TankData*, ActionRequest>> actions;
-    for (TankData& td : tanks) {
-        if (!this->board->isObjectOnBoard(td.tank)) { // Skip dead tanks
-            continue;
-        }
-        ActionRequest req = td.algorithm->getAction();
-        actions.emplace_back(&td, req);
-    }
-    return actions;
+void GameManager::reserveRemovalBuffers() {
+    // This function sizes the buffers of destroyed tanks for all tanks of the board. Tanks are destroyed rarely,
+    // so growing the buffers on use would allocate long after the first steps.
+    const size_t tank_count = board->getAllTanks().size();
+    dead_tanks.reserve(tank_count);
+    tanks_to_remove.reserve(2 * tank_count); // the first player 1 tank is added once per player 2 tank it meets
+    cell_tanks.reserve(tank_count);
+    mines_to_remove.reserve(1); // only the first mine is checked against tanks
 }
 
-
-std::list<std::tuple<TankData*, ActionRequest, bool>> GameManager::processRequests(const std::vector<std::pair<TankData*, ActionRequest>>& actions) {
-    // This function processes the gathered action requests and executes them.
-    std::list<std::tuple<TankData*,ActionRequest ,bool>> approved_actions;
+void GameManager::processRequests(const std::vector<std::pair<TankData*, ActionRequest>>& actions, std::vector<std::tuple<TankData*, ActionRequest, bool>>& approved_actions) {
+    // This function processes the gathered action requests and appends each with its approval to approved_actions.
     for (const auto& [td, req] : actions) {
         if (!this->board->isObjectOnBoard(td->tank)) {
             continue;
@@ -94,7 +92,6 @@ std::list<std::tuple<TankData*, ActionRequest, bool>> GameManager::processReques
             approved_actions.emplace_back(td,req,false);
         }
     }
-    return approved_actions;
 }
 
 bool GameManager::isActionLegal(Tank* tank, ActionRequest action) const {
@@ -201,7 +198,9 @@ void GameManager::executeMoveForward(TankData* td) {
     }
 
     // Perform move forward
+    Point old_pos = tank->getPosition();
     tank->moveForward(board->getCols(), board->getRows());
+    board->moveObject(tank, old_pos);
     // Point newPos = tank->getPosition();
 
     // logger->logActionDetailed(current_step, "Tank " + std::to_string(tankId) + " moved forward to (" +
@@ -226,7 +225,9 @@ void GameManager::executeMoveBackward(TankData* td) {
     }
     else if (backward_steps == 3) {
         // Execute actual backward move
+        Point old_pos = tank->getPosition();
         tank->moveBackward(board->getCols(), board->getRows());
+        board->moveObject(tank, old_pos);
         // Point new_pos = tank->getPosition();
         tank->setBackwardSteps(0); // Reset backward steps after moving
         // logger->logActionDetailed(current_step, "Tank " + std::to_string(tankId) + " moved backward to (" +std::to_string(newPos.getX()) + ", " + std::to_string(newPos.getY()) + ").","");
@@ -273,14 +274,7 @@ void GameManager::executeShoot(TankData* td) {
     Point shell_pos = shell.getPosition();
     bool dont_add_shell_to_board = false;
     if (board->isWallAt(shell_pos)) { 
-        Wall* wall = dynamic_cast<Wall*>(board->getObjectAt(shell_pos));
-        if (wall) {
-            if (wall->getHitCount() == 0) {
-                wall->incrementHitCount();
-            } else {
-                board->removeWall(wall);
-            }
-        }
+        board->hitWall(board->getWallAt(shell_pos));
         dont_add_shell_to_board = true;
     }
     if (!dont_add_shell_to_board) {
@@ -350,9 +344,12 @@ GameResult GameManager::runGameLoop() {
     // This function runs the main game loop, processing player actions and updating the game state.
     while (!game_over && current_step <= board->getMaxSteps()) {
         current_step++;
-        std::vector<std::pair<TankData*, ActionRequest>> requests = gatherRequests();
-        auto processed = processRequests(requests);
-        executeRequests(processed); 
+        // The step buffers are members, after the first step they have the capacity they need
+        step_requests.clear();
+        step_actions.clear();
+        gatherRequests(step_requests);
+        processRequests(step_requests, step_actions);
+        executeRequests(step_actions); 
         if (isGameOver()) {
             game_over = true; // Set game over flag if the game is over
             return writeGameResult(); // Exit if the game is over
@@ -364,8 +361,17 @@ GameResult GameManager::runGameLoop() {
             return writeGameResult(); // Exit if the game is over
         }
         updateGameStatus();
+        if (cycle_search && !game_over) {
+            skipRepeatedCycles();
+        }
+        if (fast_forward && !game_over && current_step >= next_tie_check) {
+            next_tie_check = current_step + kTieCheckInterval;
+            if (isTieDecided()) {
+                return writeDecidedTie();
+            }
+        }
     }
-    return GameResult{-1, GameResult::MAX_STEPS, {}, nullptr, 0}; // Return empty result if game is not over
+    return writeGameResult(); // the loop also ends when the no-ammo countdown runs out
 }
 
 void GameManager::updateGameStatus() { 
@@ -418,171 +424,127 @@ bool GameManager::isGameOver() {
     }
 }
 
-void GameManager::checkCollisions() {
-    // this function calls all check collision options.
-    checkShellWallCollisions();
-    checkShellTankCollisions();
-    checkShellShellCollisions();
-    checkTankMineCollisions();
-    checkTankTankCollision();
-}
-
-void GameManager::checkShellWallCollisions() {
-    // This function checks for collisions between shells and walls and
-    // removing shells and walls that are not existed anymore.
-    const std::vector<Shell*>& shells = board->getShells();
-    const std::vector<Wall*>& walls = board->getWalls();
-    std::vector<Shell*> shells_to_remove;
-    std::vector<Wall*> walls_to_remove;
-    for (Shell* shell : shells) {
-        Point shell_pos = shell->getPosition();
-        for (Wall* wall : walls) {
-            if (wall->getPosition() == shell_pos) {
-                // Collision detected
-                if (wall->getHitCount() == 0) {
-                    // logger->logLineDetailed("Shell " + std::to_string(shell->getId()) +
-                    //     " hit a wall at (" + std::to_string(shell_pos.getX()) + ", " +std::to_string(shell_pos.getY()) + ")");
-                    wall->incrementHitCount();
-                }
-                else {
-                    walls_to_remove.push_back(wall);
-                    // logger->logLineDetailed("Wall at (" + std::to_string(shell_pos.getX()) + ", " +std::to_string(shell_pos.getY()) + ") destroyed.");
-                }
-                shells_to_remove.push_back(shell);
-            }
-        }
-    }
-    for (Shell* shell : shells_to_remove) {
-        board->removeShell(shell);
+int GameManager::cellIndex(const Point& p) const {
+    // This function returns the index of the cell of a position on the board (x is the row, y the column)
+    return p.getX() * board->getCols() + p.getY();
+}
+
+void GameManager::clearCellBuckets() {
+    // This function empties the cell buckets; only the cells filled since the last clear are touched
+    const size_t cell_count = static_cast<size_t>(board->getRows()) * static_cast<size_t>(board->getCols());
+    if (cell_first.size() != cell_count) {
+        cell_first.assign(cell_count, -1);
+        cell_last.assign(cell_count, -1);
+        occupied_cells.clear(); // the cells of the last board do not apply to this one
     }
-    for (Wall* wall : walls_to_remove) {
-        board->removeWall(wall);
+    for (int cell : occupied_cells) {
+        cell_first[cell] = -1;
+        cell_last[cell] = -1;
     }
+    occupied_cells.clear();
+    cell_occupants.clear();
 }
 
-void GameManager::checkShellShellCollisions() {
-    // This function checks for collisions between shells and removing shells that are not existed anymore
-    std::vector<Shell*> shells = board->getShells();
-    std::vector<Shell*> to_remove;
+void GameManager::addToCellBucket(GameObject* object) {
+    // This function appends the object to the bucket of its cell, so each bucket keeps the order of insertion
+    const int cell = cellIndex(object->getPosition());
+    const int index = static_cast<int>(cell_occupants.size());
+    cell_occupants.push_back({object, -1});
+    if (cell_first[cell] == -1) {
+        cell_first[cell] = index;
+        occupied_cells.push_back(cell);
+    } else {
+        cell_occupants[cell_last[cell]].next = index;
+    }
+    cell_last[cell] = index;
+}
 
-    for (size_t i = 0; i < shells.size(); ++i) {
-        if (!this->board->isObjectOnBoard(shells[i])) {
-            continue; // Skip dead shells
-        }
-        for (size_t j = i + 1; j < shells.size(); ++j) {
-            if (!this->board->isObjectOnBoard(shells[j])) {
-                continue; // Skip dead shells
+void GameManager::checkCollisions() {
+    // This function resolves all collisions of the step in one pass over the occupied cells.
+    // Within a cell the rules apply in the order of the former separate passes: shells hit the wall, then
+    // the first tank, then each other, and the tanks left standing on the mine step on it. As before, only
+    // the first mine on the board and the first player 1 tank are checked against tanks.
+    std::span<Mine* const> mines = board->getMines();
+    Mine* first_mine = mines.empty() ? nullptr : mines.front();
+    // Any shell may be destroyed, so these only grow when more shells than ever before are in flight
+    shells_to_remove.reserve(board->getShells().size());
+    cell_shells.reserve(board->getShells().size());
+    shells_to_remove.clear();
+    tanks_to_remove.clear();
+    walls_to_remove.clear(); // walls are hit in place, see GameBoard::hitWall
+    mines_to_remove.clear();
+
+    clearCellBuckets();
+    for (Tank* tank : board->getAllTanks()) {
+        addToCellBucket(tank);
+    }
+    for (Shell* shell : board->getShells()) {
+        addToCellBucket(shell);
+    }
+    for (int cell : occupied_cells) {
+        cell_tanks.clear();
+        cell_shells.clear();
+        for (int i = cell_first[cell]; i != -1; i = cell_occupants[i].next) {
+            GameObject* object = cell_occupants[i].object;
+            if (object->getType() == GameObject::Type::Tank) {
+                cell_tanks.push_back(static_cast<Tank*>(object));
+            } else {
+                cell_shells.push_back(static_cast<Shell*>(object));
             }
-            if (shells[i]->getPosition() == shells[j]->getPosition()) {
-                // Collision detected
-                if (std::find(to_remove.begin(), to_remove.end(), shells[i]) == to_remove.end()) {
-                    to_remove.push_back(shells[i]); 
-                }
-                if (std::find(to_remove.begin(), to_remove.end(), shells[j]) == to_remove.end()) {
-                    to_remove.push_back(shells[j]); 
+        }
+        const Point pos = cell_occupants[cell_first[cell]].object->getPosition();
+        if (!cell_shells.empty()) {
+            bool shells_destroyed = true;
+            if (board->isWallAt(pos)) {
+                // The first shell to hit an intact wall damages it, any further hit destroys it
+                Wall* wall = board->getWallAt(pos);
+                for (size_t i = 0; i < cell_shells.size(); ++i) {
+                    board->hitWall(wall);
                 }
-                // logger->logLineDetailed("Shells collided at (" + std::to_string(shells[i]->getPosition().getX()) + ", " +
-                    // std::to_string(shells[i]->getPosition().getY()) + ") and both exploded.");
+            } else if (!cell_tanks.empty()) {
+                // Every shell in the cell hits the first tank, the other tanks are not hit
+                cell_tanks.front()->setAlive();
+                tanks_to_remove.push_back(cell_tanks.front());
+                cell_tanks.erase(cell_tanks.begin());
+            } else {
+                shells_destroyed = cell_shells.size() > 1; // shells meeting in a cell destroy each other
+            }
+            if (shells_destroyed) {
+                shells_to_remove.insert(shells_to_remove.end(), cell_shells.begin(), cell_shells.end());
+            }
         }
-    }
-}
-// Remove the shells that collided
-for (Shell* s : to_remove) {
-    board->removeShell(s);
-    }
-}
-
-void GameManager::checkShellTankCollisions() {
-    // This function checks for collisions between shells and tank and update game over if a coliision is detected
-    const std::vector<Shell*>& shells = board->getShells();
-    const std::vector<Tank*>& tanks = board->getAllTanks();
-    std::vector<Shell*> shells_to_remove;
-    std::vector<Tank*> tanks_to_remove;
-    for (Shell* shell : shells) {
-        Point shell_pos = shell->getPosition();
-        for (Tank* tank : tanks) {
-            if (!this->board->isObjectOnBoard(tank)) {continue;}
-            Point tank_pos = tank->getPosition();
-            if (tank && shell_pos == tank_pos) {
+        if (first_mine && first_mine->getPosition() == pos && !cell_tanks.empty()) {
+            for (Tank* tank : cell_tanks) {
                 tank->setAlive();
-                // logger->logLineDetailed("Shell " + std::to_string(shell->getId()) + " hit Tank " + std::to_string(tank->getId()) +" at (" +
-                // std::to_string(shell_pos.getX()) + ", " + std::to_string(shell_pos.getY()) + "). This Tank is player" +
-                // std::to_string(board->getTankPlayerId(tank)) + " and it destroyed.");
                 tanks_to_remove.push_back(tank);
-                shells_to_remove.push_back(shell);
-                break; // Exit the inner loop after first collision
             }
+            mines_to_remove.push_back(first_mine);
         }
     }
-    for (Shell* shell : shells_to_remove) {
-        board->removeShell(shell);
-    }
-    for (Tank* tank : tanks_to_remove) {
-        board->removeTank(tank);
-    }
-}
+    removeCollidedItems(shells_to_remove, tanks_to_remove, walls_to_remove, mines_to_remove);
 
-
-void GameManager::checkTankMineCollisions() {
-    // This function checks for collisions between shells and mines
-    std::vector<Mine*> mines_to_remove;
-    std::vector<Tank*> tanks_to_remove;
-    const std::vector<Mine*>& mines = board->getMines();
-    const std::vector<Tank*>& tanks = board->getAllTanks();
-    for (Mine* mine : mines) {
-        Point mine_pos = mine->getPosition();
-        for (Tank* tank: tanks ) {
-            if (!this->board->isObjectOnBoard(tank)) {continue;}
-            Point tank_pos = tank->getPosition();
-            if (tank && mine_pos == tank_pos) { // Collision detected: tank on mine
-            tank->setAlive(); 
-            // logger->logLineDetailed("Tank " + std::to_string(tank->getId()) + " of player " + std::to_string(board->getTankPlayerId(tank)) +
-            // " stepped on a mine at (" + std::to_string(tank_pos.getX()) + ", " + std::to_string(tank_pos.getY()) + "). Both are destroyed.");
-            
-            tanks_to_remove.push_back(tank);
-            mines_to_remove.push_back(mine);
-            }
-        }
-        break;  // Exit the loop after first mine collision
-    }
-    // Remove the mines that were stepped on
-    for (Mine* mine : mines_to_remove) {
-        board->removeMine(mine);
-    }
-    for (Tank* tank : tanks_to_remove) {
-        board->removeTank(tank);
+    // The first player 1 tank left on the board collides with every player 2 tank in its cell
+    std::span<Tank* const> tanks1 = board->getTanksPlayer(1);
+    if (tanks1.empty()) {
+        return;
     }
-}
-
-
-void GameManager::checkTankTankCollision() { 
-    // Check for collisions between tanks and if a collision detected
-    std::vector<Tank*> tanks1 = board->getTanksPlayer(1);
-    std::vector<Tank*> tanks2 = board->getTanksPlayer(2);
-    std::vector<Tank*> tanks_to_remove;
-     
-    for (Tank* tank1 : tanks1) {
-        if (!this->board->isObjectOnBoard(tank1)) {continue;}
-        Point tank1_pos = tank1->getPosition();
-        for (Tank* tank2: tanks2 ) {
-            if (!this->board->isObjectOnBoard(tank2)) {continue;}
-            Point tank2_pos = tank2->getPosition();
-            if (tank1 && tank2 && tank1_pos == tank2_pos) {
-                tank1->setAlive();
-                tank2->setAlive();
-                // logger->logLineDetailed("Tank " + std::to_string(tank1->getId()) + " of player 1 and Tank" + std::to_string(tank2->getId()) + " of player 2 collided at (" +
-                //     std::to_string(tank1_pos.getX()) + ", " +
-                //     std::to_string(tank1_pos.getY()) + "). Both are destroyed.");
+    Tank* tank1 = tanks1.front();
+    tanks_to_remove.clear();
+    for (int i = cell_first[cellIndex(tank1->getPosition())]; i != -1; i = cell_occupants[i].next) {
+        GameObject* object = cell_occupants[i].object;
+        if (object->getType() != GameObject::Type::Tank || !board->isObjectOnBoard(object)) {
+            continue;
+        }
+        Tank* tank2 = static_cast<Tank*>(object);
+        if (tank2->getPlayerIndex() == 2) {
+            tank1->setAlive();
+            tank2->setAlive();
             tanks_to_remove.push_back(tank1);
             tanks_to_remove.push_back(tank2);
-            }
         }
-        break;
     }
-
-     for (Tank* tank : tanks_to_remove) {
+    for (Tank* tank : tanks_to_remove) {
         board->removeTank(tank);
-        
     }
 }
 
@@ -598,7 +560,7 @@ void GameManager::gatherRequests(std::vector<std::pair<TankData*, ActionRequest>
     }
 }
 
-void GameManager::executeRequests(const std::list<std::tuple<TankData*, ActionRequest, bool>>& actions) {
+void GameManager::executeRequests(const std::vector<std::tuple<TankData*, ActionRequest, bool>>& actions) {
     // This function  the gathered action requests and updates the game state.
     for (const auto& [td, req, is_approved] : actions) {
         if (!this->board->isObjectOnBoard(td->tank)) {
@@ -614,10 +576,10 @@ void GameManager::executeRequests(const std::list<std::tuple<TankData*, ActionRe
 }
 
 
-void GameManager:: consolidateActions(const std::list<std::tuple<TankData*, ActionRequest, bool>>& actions) {
+void GameManager:: consolidateActions(const std::vector<std::tuple<TankData*, ActionRequest, bool>>& actions) {
     //This function consolidates the actions of all tanks and updates their states.
     int i = 1, j = 1;
-    std::vector<int> dead_tanks;
+    dead_tanks.clear();
     for (TankData& td : tanks) {
         if (!this->board->isObjectOnBoard(td.tank)) { dead_tanks.push_back(i);}
         i++; // get dead tanks index
@@ -695,7 +657,7 @@ GameResult GameManager::writeGameResult() {
         game_over = false; // Game is still ongoing
         return GameResult{-1, GameResult::MAX_STEPS, {}, nullptr, 0}; // Return empty result if game is not over
     }	
-    return GameResult{-1, GameResult::MAX_STEPS, {}, nullptr, 0};
+    return result;
 }
 
 int GameManager::countAliveTanks(int player_index) {
@@ -721,50 +683,73 @@ void GameManager::updateShellsLocation() {
 }
 
 void GameManager::checkShellFutureCollisions(int square) {
-    // This function check if shells will be detected as collided in specific offset
-    const std::vector<Shell*>& shells = board->getShells();
-    std::vector <Shell*> shells_to_remove;
-    std::vector <Tank*> tanks_to_remove;
-    std::vector<Wall*> walls_to_remove;
-    std::vector<Mine*> mines_to_remove;
+    // This function check if shells will be detected as collided in specific offset.
+    // Tanks (destroyed ones too, at their last position) and shells are bucketed by cell first,
+    // so each shell only looks at the cell it is about to enter.
+    std::span<Shell* const> shells = board->getShells();
+    // Each shell adds itself up to three times, the shell it hits, a tank, a wall and a mine. Sized by the shells
+    // in flight, the buffers only grow when more shells than ever before are.
+    shells_to_remove.reserve(4 * shells.size());
+    tanks_to_remove.reserve(shells.size());
+    walls_to_remove.reserve(shells.size());
+    mines_to_remove.reserve(shells.size());
+    shells_to_remove.clear();
+    tanks_to_remove.clear();
+    walls_to_remove.clear();
+    mines_to_remove.clear();
+    clearCellBuckets();
+    for (TankData& tank : tanks) {
+        addToCellBucket(tank.tank);
+    }
     for (Shell* shell : shells) {
-        if (this->board->isObjectOnBoard(shell) && !shell->getNewShell()) {
-            Point original_position = shell->getPosition();
-            std::pair <int, int> offset = directionOffset(shell->getDirection());
-            // Check collisions using the new position
-            int new_x = (original_position.getX() + square * offset.first + board->getCols()) % board->getCols();
-            int new_y = (original_position.getY() + square * offset.second + board->getRows()) % board->getRows();
-            Point new_position(new_x, new_y);
+        addToCellBucket(shell);
+    }
+    bool game_over_checked = false;
+    for (Shell* shell : shells) {
+        if (!this->board->isObjectOnBoard(shell) || shell->getNewShell()) {
+            continue;
+        }
+        Point original_position = shell->getPosition();
+        std::pair <int, int> offset = directionOffset(shell->getDirection());
+        // Check collisions using the new position
+        int new_x = (original_position.getX() + square * offset.first + board->getRows()) % board->getRows();
+        int new_y = (original_position.getY() + square * offset.second + board->getCols()) % board->getCols();
+        Point new_position(new_x, new_y);
+        Tank* hit_tank = nullptr;
+        Shell* hit_shell = nullptr;
+        for (int i = cell_first[cellIndex(new_position)]; i != -1; i = cell_occupants[i].next) {
+            GameObject* object = cell_occupants[i].object;
+            if (object->getType() == GameObject::Type::Tank) {
+                if (!hit_tank) hit_tank = static_cast<Tank*>(object);
+            } else if (object != shell && !hit_shell) {
+                hit_shell = static_cast<Shell*>(object);
+            }
+        }
+        if (hit_tank) { // Collision detected with the first tank in the cell
+            shells_to_remove.push_back(shell);
+            tanks_to_remove.push_back(hit_tank);
             for (TankData& tank : tanks) {
-                if (tank.tank->getPosition() == new_position) {// Collision detected
-                    shells_to_remove.push_back(shell);
-                    tanks_to_remove.push_back(tank.tank);
-                    tank.alive = false;
-                    break;
-                }
+                if (tank.tank == hit_tank) tank.alive = false;
             }
-            if(isGameOver()) {
+        }
+        // Nothing is removed during the check, so the answer is the same for every shell
+        if (!game_over_checked) {
+            game_over_checked = true;
+            if (isGameOver()) {
                 return; // Exit if the game is over
             }
-            for (Shell* other_shell : shells) {
-                if (other_shell != shell && other_shell->getPosition() == new_position) { // Collision detected
-                    shells_to_remove.push_back(shell);
-                    shells_to_remove.push_back(other_shell);
-                    break;
-                }
-            }
-            for (Wall* wall : board->getWalls()) { // Collision with wall
-                if (wall->getPosition() == new_position) {
-                    shells_to_remove.push_back(shell);
-                    walls_to_remove.push_back(wall);
-                }
-            }
-            for (Mine* mine : board->getMines()) { // Collision with mine
-                if (mine->getPosition() == new_position) {
-                    shells_to_remove.push_back(shell);
-                    mines_to_remove.push_back(mine);
-                }
-            }
+        }
+        if (hit_shell) { // Collision detected with another shell
+            shells_to_remove.push_back(shell);
+            shells_to_remove.push_back(hit_shell);
+        }
+        if (board->isWallAt(new_position)) { // Collision with wall
+            shells_to_remove.push_back(shell);
+            walls_to_remove.push_back(board->getWallAt(new_position));
+        }
+        if (board->isMineAt(new_position)) { // Collision with mine
+            shells_to_remove.push_back(shell);
+            mines_to_remove.push_back(board->getMineAt(new_position));
         }
     }
     removeCollidedItems(shells_to_remove, tanks_to_remove, walls_to_remove, mines_to_remove); // Remove items that collided
@@ -791,26 +776,165 @@ void GameManager::removeCollidedItems(const std::vector<Shell*>& shells_to_remov
 }
 
 void GameManager::moveShellTwoPoints() {
-    // This function moves shell  by two points ahead toward their direction
-    const std::vector<Shell*>& shells = board->getShells();
+    // This function moves shell  by two points ahead toward their direction.
+    // The moving shells are advanced together in shell_batch and written back in board order,
+    // so the cell index sees the same sequence of moves as when each shell moved on its own.
+    std::span<Shell* const> shells = board->getShells();
+    shell_batch.clear();
+    moving_shells.clear();
+    for (Shell* shell : shells) {
+        if (!this->board->isObjectOnBoard(shell) || shell->getNewShell()) {
+            continue; // Skip dead shells, a new shell starts moving in the next step
+        }
+        moving_shells.push_back(shell);
+        shell_batch.add(shell->getPosition(), shell->getDirection());
+    }
+    shell_batch.advance(board->getRows(), board->getCols());
+    for (size_t i = 0; i < moving_shells.size(); ++i) {
+        Shell* shell = moving_shells[i];
+        Point old_pos = shell->getPosition();
+        shell->setPosition(shell_batch.position(i));
+        board->moveObject(shell, old_pos);
+    }
     for (Shell* shell : shells) {
-        if (!this->board->isObjectOnBoard(shell)) {
-            continue; // Skip dead shells
+        if (shell->getNewShell()) {
+            shell->setNewShell();
         }
-        if (shell != nullptr && !shell->getNewShell()) {
-            // Move the shell by 2 points
-            shell->move(board->getCols(), board->getRows());
-            // logger->logLineDetailed("Shell " + std::to_string(shell->getId()) + " moved to (" +
-            //     std::to_string(shell->getPosition().getX()) + ", " +
-            //     std::to_string(shell->getPosition().getY()) + ")");
-        }        
+    }
+}
+
 
-    if (shell->getNewShell()) {
-        shell->setNewShell();
+void GameManager::setFastForward(bool enabled) {
+    fast_forward = enabled;
+}
+
+void GameManager::startFastForward() {
+    // This function enables the cycle search of a game whose players and tank algorithms all hash their state,
+    // puts the first mark on the state before the first step and schedules the first early tie check
+    next_tie_check = 0;
+    cycle_search = fast_forward;
+    for (const Player* player : players) {
+        cycle_search = cycle_search && dynamic_cast<const StateHashable*>(player) != nullptr;
+    }
+    for (const TankData& td : tanks) {
+        cycle_search = cycle_search && dynamic_cast<const StateHashable*>(td.algorithm.get()) != nullptr;
+    }
+    if (cycle_search) {
+        mark_board_hash = boardStateHash();
+        mark_agents_hash = agentsStateHash();
+        mark_step = current_step;
+        mark_distance = 1;
+    }
+}
+
+void GameManager::skipRepeatedCycles() {
+    // This function compares the state after the step with the mark; players and tank algorithms are only hashed
+    // when the board matches and when the mark moves. A repeated state repeats the game from there with that period:
+    // tanks are only ever removed, so none dies in it, and the countdown after the ammo runs out is part of the state,
+    // so the game can only end at MaxSteps. The whole periods before the last step are skipped and the rest is played,
+    // which leaves the final board and result of the full game.
+    const std::uint64_t board_hash = boardStateHash();
+    if (board_hash == mark_board_hash && agentsStateHash() == mark_agents_hash) {
+        const int period = current_step - mark_step;
+        const int last_step = board->getMaxSteps() - 1;
+        if (current_step < last_step) {
+            current_step += (last_step - current_step) / period * period;
+        }
+        cycle_search = false;
+        return;
+    }
+    if (current_step - mark_step == mark_distance) {
+        mark_board_hash = board_hash;
+        mark_agents_hash = agentsStateHash();
+        mark_step = current_step;
+        mark_distance *= 2;
     }
- }
 }
 
+bool GameManager::isTieDecided() {
+    // This function checks the cheap conditions first, then fills the region of every tank through the cells that are
+    // neither walls nor mines. Reaching a mine or a cell of another tank's region means a tank might still die.
+    if (!board->getShells().empty()) {
+        return false;
+    }
+    std::span<Tank* const> tanks_on_board = board->getAllTanks();
+    for (const Tank* tank : tanks_on_board) {
+        if (tank->canEverShoot()) {
+            return false;
+        }
+    }
+    const int rows = board->getRows();
+    const int cols = board->getCols();
+    cell_region.assign(static_cast<size_t>(rows) * static_cast<size_t>(cols), 0);
+    for (size_t i = 0; i < tanks_on_board.size(); ++i) {
+        const int region = static_cast<int>(i) + 1;
+        const int start = cellIndex(tanks_on_board[i]->getPosition());
+        if (cell_region[start] != 0) {
+            return false; // the tank is in the region of an earlier one
+        }
+        cell_region[start] = region;
+        region_queue.clear();
+        region_queue.push_back(start);
+        for (size_t head = 0; head < region_queue.size(); ++head) {
+            const int x = region_queue[head] / cols;
+            const int y = region_queue[head] % cols;
+            for (int dx = -1; dx <= 1; ++dx) {
+                for (int dy = -1; dy <= 1; ++dy) {
+                    const Point next((x + dx + rows) % rows, (y + dy + cols) % cols);
+                    if (board->isWallAt(next)) {
+                        continue;
+                    }
+                    if (board->isMineAt(next)) {
+                        return false;
+                    }
+                    const int index = cellIndex(next);
+                    if (cell_region[index] == 0) {
+                        cell_region[index] = region;
+                        region_queue.push_back(index);
+                    } else if (cell_region[index] != region) {
+                        return false;
+                    }
+                }
+            }
+        }
+    }
+    return true;
+}
+
+GameResult GameManager::writeDecidedTie() {
+    // This function ends a game whose tie isTieDecided proved: no tank dies and the ammo never changes any more,
+    // so a running no-ammo countdown ends the game unless MaxSteps comes first, as in runGameLoop
+    const int max_steps = board->getMaxSteps();
+    if (remaining_step_after_amo > 0 && current_step + remaining_step_after_amo < max_steps) {
+        current_step += remaining_step_after_amo;
+        remaining_step_after_amo = 0;
+    } else {
+        current_step = max_steps;
+    }
+    game_over = true;
+    return writeGameResult();
+}
+
+std::uint64_t GameManager::boardStateHash() const {
+    // This function adds the no-ammo countdown, the only game state kept outside the board, to the board hash
+    return combineStateHash(board->stateHash(), static_cast<std::uint64_t>(remaining_step_after_amo));
+}
+
+std::uint64_t GameManager::agentsStateHash() const {
+    // This function hashes the players and the algorithms of the tanks on the board, startFastForward made sure
+    // they all implement StateHashable
+    std::uint64_t hash = 0;
+    for (const Player* player : players) {
+        hash = combineStateHash(hash, dynamic_cast<const StateHashable*>(player)->stateHash());
+    }
+    for (const TankData& td : tanks) {
+        if (!this->board->isObjectOnBoard(td.tank)) {
+            continue;
+        }
+        hash = combineStateHash(hash, dynamic_cast<const StateHashable*>(td.algorithm.get())->stateHash());
+    }
+    return hash;
+}
 
 bool GameManager::allTanksOutOfAmmo() {
     // Check if all tanks are out of ammunition
@@ -6,7 +6,10 @@
 #include "common/TankAlgorithm.h"
 #include "common/GameResult.h"
 #include "GameBoard.h"
-#include <list>
+#include "ShellBatch.h"
+#include "UserCommon/FastForwardGameManager.h"
+#include <cstdint>
+#include <tuple>
 #include <memory>
 #include <vector>
 #include <string>
@@ -34,7 +37,7 @@ struct TankData
  */
 namespace GameManager_206480972_206899163 {
 
-class GameManager : public AbstractGameManager {  
+class GameManager : public AbstractGameManager, public FastForwardGameManager {
 private: 
     std::unique_ptr<GameBoard> board; // The game board
     std::unique_ptr<PlayerFactory> playerFactory;        ///< Factory for creating players
@@ -45,6 +48,49 @@ private:
     int current_step = 0; // Current step number
     bool game_over = false; // Whether the game is over
     bool verbose; // Whether to log detailed information
+    /**
+     * @brief An entry of a cell bucket: a tank or shell and the next entry of the same cell.
+     */
+    struct CellOccupant {
+        GameObject* object; ///< Tank or shell in the cell
+        int next;           ///< Index of the next occupant of the same cell, -1 for the last one
+    };
+    // Tanks and shells grouped by board cell for the collision checks. The buckets are refilled before each
+    // check and only the cells filled last time are cleared, so a check costs O(tanks + shells), not O(rows * cols).
+    std::vector<int> cell_first;               ///< Per cell, index of its first occupant in cell_occupants, -1 if empty
+    std::vector<int> cell_last;                ///< Per cell, index of its last occupant in cell_occupants
+    std::vector<CellOccupant> cell_occupants;  ///< Occupants of all cells, each cell in insertion order
+    std::vector<int> occupied_cells;           ///< Cells with at least one occupant, in the order they were filled
+    ShellBatch shell_batch;                    ///< Positions and offsets of the shells moving in this step
+    std::vector<Shell*> moving_shells;         ///< The shells in shell_batch, in the same order
+    // Per-step scratch buffers. They are cleared, not freed, so once the first steps have grown them
+    // the game loop itself does not allocate.
+    std::vector<std::pair<TankData*, ActionRequest>> step_requests; ///< Requests of the tanks on the board
+    std::vector<std::tuple<TankData*, ActionRequest, bool>> step_actions; ///< step_requests with their approval
+    std::vector<int> dead_tanks;               ///< 1-based indices into tanks of the tanks already destroyed
+    std::vector<Shell*> shells_to_remove;      ///< Shells destroyed by the current collision check
+    std::vector<Tank*> tanks_to_remove;        ///< Tanks destroyed by the current collision check
+    std::vector<Wall*> walls_to_remove;        ///< Walls destroyed by the current collision check
+    std::vector<Mine*> mines_to_remove;        ///< Mines destroyed by the current collision check
+    std::vector<Tank*> cell_tanks;             ///< Tanks of the cell being resolved
+    std::vector<Shell*> cell_shells;           ///< Shells of the cell being resolved
+    // Fast forward: Brent's cycle search over the state after each step. The state is compared with the one at a mark,
+    // and the mark moves to the current step whenever the distance to it reaches the next power of two, so a cycle is
+    // found within a few periods of its start, with O(1) work and no memory per step.
+    bool fast_forward = false;          ///< Whether repeated cycles are skipped, off by default
+    bool cycle_search = false;          ///< Whether the current game is searched for a cycle
+    std::uint64_t mark_board_hash = 0;  ///< Board state hash at the mark
+    std::uint64_t mark_agents_hash = 0; ///< Players and tank algorithms state hash at the mark
+    int mark_step = 0;                  ///< Step of the mark
+    int mark_distance = 1;              ///< Distance from the mark at which the mark moves on
+    // Early tie, also part of fast forward: once no shell flies and no tank can shoot again, walls and mines never change
+    // and every tank stays in its region of the board, the cells it reaches through free cells (8 directions, across the edges).
+    // A tank alone in a region without mines can never die, and when that holds for every tank the game can only end
+    // as a tie at MaxSteps or by the no-ammo countdown. The check runs every kTieCheckInterval steps.
+    static constexpr int kTieCheckInterval = 16; ///< Steps between two early tie checks
+    int next_tie_check = 0;             ///< Step of the next early tie check
+    std::vector<int> cell_region;       ///< Per cell, 1 + index of the tank whose region holds it, 0 outside all regions
+    std::vector<int> region_queue;      ///< Cells of the region being filled
 public:
     GameManager(bool verbose) : verbose(verbose) {}
     GameResult run(size_t map_width, size_t map_height, const SatelliteView& map, // <= a snapshot, NOT updated
@@ -58,14 +104,22 @@ public:
     GameManager& operator=(GameManager&&) noexcept = default;
     ~GameManager() = default;
 
+    /**
+     * @brief Turns fast forward on or off for the following games, see FastForwardGameManager.
+     *        A game is only searched for cycles when both players and all tank algorithms implement StateHashable.
+     *        A game whose tie is decided ends early, see isTieDecided; its final state is the board at that step.
+     * @param enabled Whether repeated cycles are skipped.
+     */
+    void setFastForward(bool enabled) override;
+
 private:
     void initAllTanksSorted(TankAlgorithmFactory player1_tank_algo_factory, TankAlgorithmFactory player2_tank_algo_factory);
-    std::vector <std::pair<TankData*, ActionRequest>> gatherRequests();
-    std::list<std::tuple<TankData*, ActionRequest, bool>> processRequests(const std::vector<std::pair<TankData*, ActionRequest>>& actions);
+    void processRequests(const std::vector<std::pair<TankData*, ActionRequest>>& actions, std::vector<std::tuple<TankData*, ActionRequest, bool>>& approved_actions);
     bool isActionLegal(Tank* tank, ActionRequest action) const;
     Point getNextPosition(const Point& pos, Direction dir, int steps) const;
-    void executeRequests(const std::list<std::tuple<TankData*, ActionRequest, bool>>& actions);
+    void executeRequests(const std::vector<std::tuple<TankData*, ActionRequest, bool>>& actions);
     void resetGameState();
+    void reserveRemovalBuffers();
     GameResult buildImmediateResult(const std::vector<Tank*>& p1_tanks, const std::vector<Tank*>& p2_tanks) const;
     bool checkImmediateEnd(const std::vector<Tank*>& p1_tanks, const std::vector<Tank*>& p2_tanks);
     void immediateLoseOrTie(const std::vector<Tank*>& p1_tanks, const std::vector<Tank*>& p2_tanks);
@@ -79,15 +133,13 @@ private:
     void executeShoot(TankData* td);
     void executeGetBattleInfo(TankData* td);
     int countAliveTanks(int playerId);
-    void consolidateActions(const std::list<std::tuple<TankData*, ActionRequest, bool>>& actions);
+    void consolidateActions(const std::vector<std::tuple<TankData*, ActionRequest, bool>>& actions);
     void checkCollisions();
     void checkShellFutureCollisions(int square);
-    void checkShellShellCollisions();
-    void checkShellTankCollisions();
-    void checkTankTankCollision();
+    int cellIndex(const Point& p) const;
+    void clearCellBuckets();
+    void addToCellBucket(GameObject* object);
     void checkTankWallCollisions();
-    void checkShellWallCollisions();
-    void checkTankMineCollisions();
     void updateShellsLocation();
     bool isAtLeastOneTankAlive(int playerId) const;
     bool isGameOver();
@@ -97,6 +149,12 @@ private:
     void updateGameStatus();
     void gatherRequests(std::vector<std::pair<TankData*, ActionRequest>>& actions);
     void moveShellTwoPoints();
+    void startFastForward();
+    void skipRepeatedCycles();
+    bool isTieDecided();
+    GameResult writeDecidedTie();
+    std::uint64_t boardStateHash() const;
+    std::uint64_t agentsStateHash() const;
     void removeCollidedItems(const std::vector<Shell*>& shells_to_remove,  const std::vector<Tank*>& tanks_to_remove, const std::vector<Wall*>& walls_to_remove, 
                              const std::vector<Mine*>& mines_to_remove);
     
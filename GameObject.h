@@ -12,6 +12,17 @@
  */
 class GameObject {
 public:
+    /**
+     * @brief The concrete kind of a game object, so that callers can tell objects apart without RTTI.
+     */
+    enum class Type { Tank, Wall, Mine, Shell };
+
+    /**
+     * @brief Constructs the object with its kind.
+     * @param type The kind of the derived object.
+     */
+    explicit GameObject(Type type) : type(type) {}
+
     /**
      * @brief Virtual destructor for safe polymorphic deletion.
      */
@@ -28,6 +39,28 @@ public:
      * @return The character representing the object.
      */
     virtual char toChar() const = 0; 
+
+    /**
+     * @brief Returns whether the object is currently on a game board.
+     * @return True from the moment a board places the object until the board removes it.
+     */
+    bool isOnBoard() const { return on_board; }
+
+    /**
+     * @brief Marks the object as placed on or removed from a game board. Only the board calls this.
+     * @param placed True when the object is placed, false when it is removed.
+     */
+    void setOnBoard(bool placed) { on_board = placed; }
+
+    /**
+     * @brief Gets the kind of the object.
+     * @return The type tag given by the derived class.
+     */
+    Type getType() const { return type; }
+
+private:
+    Type type;             ///< Kind of the derived object
+    bool on_board = false; ///< Set by the board that holds the object, removed objects stay allocated and read false
 };
 
 #endif // GAMEOBJECT_H
@@ -84,6 +84,24 @@ void HybridTankAlgorithm::updateStateAfterReq(ActionRequest req)
     current_step++;
 }
 
+std::uint64_t HybridTankAlgorithm::stateHash() const
+{
+    // This function hashes everything getAction reads; the configuration is constant but hashed too, it is cheap
+    const int step_period = ask_for_info_interval * recalculate_interval;
+    const int step_phase = step_period > 0 ? current_step % step_period : current_step;
+    std::uint64_t hash = combineStateHash(static_cast<std::uint64_t>(player_index), static_cast<std::uint64_t>(tank_index));
+    hash = combineStateHash(hash, static_cast<std::uint64_t>(recalculate_interval));
+    hash = combineStateHash(hash, static_cast<std::uint64_t>(shell_threat_radius));
+    hash = combineStateHash(hash, static_cast<std::uint64_t>(ask_for_info_interval));
+    hash = combineStateHash(hash, static_cast<std::uint64_t>(step_phase));
+    hash = combineStateHash(hash, future_steps.size());
+    for (const Point& step : future_steps)
+    {
+        hash = combineStateHash(combineStateHash(hash, static_cast<std::uint64_t>(step.getX())), static_cast<std::uint64_t>(step.getY()));
+    }
+    return combineStateHash(hash, battle_info.stateHash());
+}
+
 // Main decision function: determines the next action for the tank
 ActionRequest HybridTankAlgorithm::getAction()
 {
@@ -9,6 +9,7 @@
 #include "common/ActionRequest.h"
 #include "GameBoard.h"
 #include "SimpleBattleInfo.h"
+#include "UserCommon/StateHashable.h"
 
 
 
@@ -20,7 +21,7 @@
  * It uses battle info to make decisions, plans ahead, and can avoid threats such as shells.
  * Configuration parameters allow tuning of planning and threat response.
  */
-class HybridTankAlgorithm : public TankAlgorithm {
+class HybridTankAlgorithm : public TankAlgorithm, public StateHashable {
     private:
     // configuration parameters
 
@@ -65,6 +66,13 @@ class HybridTankAlgorithm : public TankAlgorithm {
      */
     ActionRequest getAction() override;
 
+    /**
+     * @brief Returns a hash of the algorithm's state: its battle info, its planned steps and the step count
+     *        modulo the battle info and path recalculation intervals, the only way the count is used.
+     * @return The hash, see StateHashable.
+     */
+    std::uint64_t stateHash() const override;
+
     /**
      * @brief Gets the next avoid action for the given tank.
      * @param tank The tank to avoid threats for.
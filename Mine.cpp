@@ -1,7 +1,7 @@
 #include "Mine.h"
 
 // Constructor
-Mine::Mine(int x, int y) : position(x, y) {}
+Mine::Mine(int x, int y) : GameObject(Type::Mine), position(x, y) {}
 
 // Getter
 Point Mine::getPosition() const {
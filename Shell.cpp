@@ -4,12 +4,12 @@
 #include "Point.h"
 
 // Constructor: Create a shell with position, direction, and owner id
-Shell::Shell(Point position, Direction dir, int id) : direction(dir), id(id), new_shell(true) {
+Shell::Shell(Point position, Direction dir, int id) : GameObject(Type::Shell), direction(dir), id(id), new_shell(true) {
     this->position = Point(position.getX(), position.getY());
 }
 
 // Constructor: Create a shell with position only (direction and id defaulted)
-Shell::Shell(Point position) : direction(Direction::None), id(0), new_shell(false) {
+Shell::Shell(Point position) : GameObject(Type::Shell), direction(Direction::None), id(0), new_shell(false) {
     this->position = Point(position.getX(), position.getY());
 }
 
@@ -34,6 +34,16 @@ bool Shell::getNewShell() const {
     return new_shell;
 }
 
+// Get the index of the shell in its board's shell list
+size_t Shell::getBoardSlot() const {
+    return board_slot;
+}
+
+// Set the index of the shell in its board's shell list
+void Shell::setBoardSlot(size_t slot) {
+    board_slot = slot;
+}
+
 // Get the character representation of the shell
 char Shell::toChar() const {
     // This function returns the character representation of the shell
@@ -4,6 +4,7 @@
 #include "Point.h"
 #include "Direction.h"
 #include "GameObject.h"
+#include <cstddef>
 #include <utility> 
 #include <iostream> 
 
@@ -20,6 +21,7 @@ private:
     Direction direction;    ///< The direction the shell is moving.
     int id;                 ///< The ID of the tank that fired the shell.
     bool new_shell;         ///< Flag indicating if the shell is newly created.
+    size_t board_slot = 0;  ///< Index of the shell in the shell list of the board that holds it.
 
 public:
     /**
@@ -75,6 +77,12 @@ public:
      */
     bool getNewShell() const; 
 
+    /**
+     * @brief Gets the index of the shell in its board's shell list. Only the board uses this.
+     * @return The index.
+     */
+    size_t getBoardSlot() const;
+
     /**
      * @brief Moves the shell one step in its direction, wrapping around the board if necessary.
      * @param boardWidth The width of the board.
@@ -95,6 +103,12 @@ public:
      */
     void setNewShell();
 
+    /**
+     * @brief Sets the index of the shell in its board's shell list. Only the board calls this.
+     * @param slot The index.
+     */
+    void setBoardSlot(size_t slot);
+
 };
 
 #endif // SHELL_H
\ No newline at end of file
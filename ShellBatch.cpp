@@ -0,0 +1,80 @@
+#include "ShellBatch.h"
+#include <utility>
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace {
+// A shell moves at most two cells, so a coordinate is at most two cells off the board. A single conditional
+// add and subtract fix it on boards of 2 or more cells, the second round covers boards a single cell wide.
+int wrap(int value, int size) {
+    for (int round = 0; round < 2; ++round) {
+        value += size & -static_cast<int>(value < 0);
+        value -= size & -static_cast<int>(value >= size);
+    }
+    return value;
+}
+
+#if defined(__SSE2__)
+__m128i wrap(__m128i value, __m128i size) {
+    for (int round = 0; round < 2; ++round) {
+        value = _mm_add_epi32(value, _mm_and_si128(_mm_cmplt_epi32(value, _mm_setzero_si128()), size));
+        value = _mm_sub_epi32(value, _mm_andnot_si128(_mm_cmplt_epi32(value, size), size));
+    }
+    return value;
+}
+#endif
+} // namespace
+
+void ShellBatch::clear() {
+    // This function empties the batch, the vectors keep their capacity for the next step
+    xs.clear();
+    ys.clear();
+    dxs.clear();
+    dys.clear();
+}
+
+void ShellBatch::add(const Point& position, Direction direction) {
+    // This function appends a shell with the single cell offset of its direction
+    std::pair<int, int> offset = directionOffset(direction);
+    xs.push_back(position.getX());
+    ys.push_back(position.getY());
+    dxs.push_back(offset.first);
+    dys.push_back(offset.second);
+}
+
+size_t ShellBatch::size() const {
+    return xs.size();
+}
+
+Point ShellBatch::position(size_t index) const {
+    return Point(xs[index], ys[index]);
+}
+
+void ShellBatch::advance(int rows, int cols) {
+    // This function moves the shells four at a time, the remaining ones go through the scalar loop
+    size_t i = 0;
+#if defined(__SSE2__)
+    const __m128i row_count = _mm_set1_epi32(rows);
+    const __m128i col_count = _mm_set1_epi32(cols);
+    for (; i + 4 <= xs.size(); i += 4) {
+        __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&xs[i]));
+        __m128i y = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&ys[i]));
+        const __m128i dx = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&dxs[i]));
+        const __m128i dy = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&dys[i]));
+        x = wrap(_mm_add_epi32(x, _mm_add_epi32(dx, dx)), row_count);
+        y = wrap(_mm_add_epi32(y, _mm_add_epi32(dy, dy)), col_count);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(&xs[i]), x);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(&ys[i]), y);
+    }
+#endif
+    advanceScalar(rows, cols, i);
+}
+
+void ShellBatch::advanceScalar(int rows, int cols, size_t first) {
+    // This function moves the shells one at a time, with the same wrap as the vector loop
+    for (size_t i = first; i < xs.size(); ++i) {
+        xs[i] = wrap(xs[i] + 2 * dxs[i], rows);
+        ys[i] = wrap(ys[i] + 2 * dys[i], cols);
+    }
+}
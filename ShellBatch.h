@@ -0,0 +1,64 @@
+#ifndef SHELL_BATCH_H
+#define SHELL_BATCH_H
+
+#include <cstddef>
+#include <vector>
+#include "Point.h"
+#include "Direction.h"
+
+/**
+ * @class ShellBatch
+ * @brief Shells that move in the current step, stored as a structure of arrays.
+ *
+ * The game manager packs the moving shells, advances all of them with one call and writes the positions back.
+ * Positions follow the engine convention: x is the row and y the column.
+ */
+class ShellBatch {
+private:
+    std::vector<int> xs;  ///< Row of each shell
+    std::vector<int> ys;  ///< Column of each shell
+    std::vector<int> dxs; ///< Row offset of a single cell move of each shell
+    std::vector<int> dys; ///< Column offset of a single cell move of each shell
+
+public:
+    /**
+     * @brief Removes all shells from the batch, keeping the allocated capacity.
+     */
+    void clear();
+
+    /**
+     * @brief Appends a shell to the batch.
+     * @param position The position of the shell.
+     * @param direction The direction the shell is moving.
+     */
+    void add(const Point& position, Direction direction);
+
+    /**
+     * @brief Returns the number of shells in the batch.
+     */
+    size_t size() const;
+
+    /**
+     * @brief Returns the position of a shell in the batch.
+     * @param index The index of the shell, in the order it was added.
+     */
+    Point position(size_t index) const;
+
+    /**
+     * @brief Moves every shell two cells in its direction, wrapping around the board, like Shell::move.
+     *        Uses SSE2 when the target supports it and advanceScalar otherwise.
+     * @param rows Number of rows on the board.
+     * @param cols Number of columns on the board.
+     */
+    void advance(int rows, int cols);
+
+    /**
+     * @brief The portable form of advance, one shell at a time.
+     * @param rows Number of rows on the board.
+     * @param cols Number of columns on the board.
+     * @param first Index of the first shell to move; the shells before it are left as they are.
+     */
+    void advanceScalar(int rows, int cols, size_t first = 0);
+};
+
+#endif // SHELL_BATCH_H
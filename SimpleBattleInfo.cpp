@@ -1,13 +1,22 @@
 #include "SimpleBattleInfo.h"
+#include "UserCommon/BulkSatelliteView.h"
+#include "UserCommon/StateHashable.h"
 #include <memory>
 #include <algorithm>
 
 // Constructor: Builds SimpleBattleInfo from a SatelliteView and player info
 SimpleBattleInfo::SimpleBattleInfo(const SatelliteView& view, size_t x, size_t y, int ammo, int player_asked)
     : rows(x), cols(y), ammo_count(ammo), boardView(x, std::vector<char>(y, ' ')), player_asked_for_info(player_asked) {
+    // A view that implements BulkSatelliteView is copied in one call, any other one is read cell by cell
+    const auto* bulk = dynamic_cast<const BulkSatelliteView*>(&view);
+    std::vector<char> cells;
+    if (bulk) {
+        cells.resize(x * y);
+        bulk->copyRows(cells.data(), y, x, y);
+    }
     for (size_t i = 0; i < x; ++i) {
         for (size_t j = 0; j < y; ++j) {
-            boardView[i][j] = view.getObjectAt(i, j);
+            boardView[i][j] = bulk ? cells[i * y + j] : view.getObjectAt(i, j);
             switch (boardView[i][j]) {
                 case '#': // Wall
                     walls.push_back(std::make_unique<Wall>(i, j));
@@ -286,3 +295,58 @@ bool SimpleBattleInfo::isObjectOnBoard(const GameObject* object) const {
     return false;
 }
 
+namespace {
+// Adds a position to a battle info hash
+std::uint64_t hashPoint(std::uint64_t hash, const Point& p) {
+    hash = combineStateHash(hash, static_cast<std::uint64_t>(p.getX()));
+    return combineStateHash(hash, static_cast<std::uint64_t>(p.getY()));
+}
+
+// Adds a tank with everything an algorithm may read or change on it to a battle info hash
+std::uint64_t hashTank(std::uint64_t hash, const Tank& tank) {
+    hash = hashPoint(hash, tank.getPosition());
+    hash = combineStateHash(hash, static_cast<std::uint64_t>(tank.getId()));
+    hash = combineStateHash(hash, static_cast<std::uint64_t>(tank.getPlayerIndex()));
+    hash = combineStateHash(hash, static_cast<std::uint64_t>(tank.getCanonDir()));
+    hash = combineStateHash(hash, static_cast<std::uint64_t>(tank.getShootingCooldown()));
+    hash = combineStateHash(hash, static_cast<std::uint64_t>(tank.getAmmoCount()));
+    hash = combineStateHash(hash, static_cast<std::uint64_t>(tank.getBackwardSteps()));
+    hash = combineStateHash(hash, static_cast<std::uint64_t>(tank.getIsAlive()));
+    hash = combineStateHash(hash, tank.getFutureSteps().size());
+    for (const Point& step : tank.getFutureSteps()) {
+        hash = hashPoint(hash, step);
+    }
+    return hash;
+}
+} // namespace
+
+std::uint64_t SimpleBattleInfo::stateHash() const {
+    // This function hashes the objects in order, each list starts with its length so lists cannot run into each other
+    std::uint64_t hash = combineStateHash(rows, cols);
+    hash = combineStateHash(hash, static_cast<std::uint64_t>(ammo_count));
+    hash = combineStateHash(hash, static_cast<std::uint64_t>(player_asked_for_info));
+    hash = combineStateHash(hash, walls.size());
+    for (const auto& wall : walls) {
+        hash = combineStateHash(hashPoint(hash, wall->getPosition()), static_cast<std::uint64_t>(wall->getHitCount()));
+    }
+    hash = combineStateHash(hash, mines.size());
+    for (const auto& mine : mines) {
+        hash = hashPoint(hash, mine->getPosition());
+    }
+    hash = combineStateHash(hash, shells.size());
+    for (const auto& shell : shells) {
+        hash = hashPoint(hash, shell->getPosition());
+        hash = combineStateHash(hash, static_cast<std::uint64_t>(shell->getDirection()));
+        hash = combineStateHash(hash, static_cast<std::uint64_t>(shell->getNewShell()));
+    }
+    hash = combineStateHash(hash, tanks1.size());
+    for (const auto& tank : tanks1) {
+        hash = hashTank(hash, *tank);
+    }
+    hash = combineStateHash(hash, tanks2.size());
+    for (const auto& tank : tanks2) {
+        hash = hashTank(hash, *tank);
+    }
+    hash = combineStateHash(hash, myTank != nullptr);
+    return myTank ? hashTank(hash, *myTank) : hash;
+}
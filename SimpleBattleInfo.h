@@ -7,6 +7,7 @@
 #include "Mine.h"
 #include <vector>
 #include <memory>
+#include <cstdint>
 
 /**
  * @class SimpleBattleInfo
@@ -182,4 +183,11 @@ public:
      * @return True if the Object is on the board, false otherwise.
      */
     bool isObjectOnBoard(const GameObject* object) const;
+
+    /**
+     * @brief Returns a hash of the battle info: board size, ammo and every wall, mine, shell and tank with its state.
+     *        The board view is left out, it is the view the objects were built from.
+     * @return The hash; equal battle infos hash equally.
+     */
+    std::uint64_t stateHash() const;
 };
\ No newline at end of file
@@ -12,6 +12,7 @@
  * @brief Manages registration and creation of algorithm and player factories for loaded .so files.
  */
 class AlgorithmRegistrar {
+public:
     /**
      * @class AlgorithmAndPlayerFactories
      * @brief Holds factories and metadata for a single algorithm/player implementation.
@@ -38,7 +39,7 @@ class AlgorithmRegistrar {
             tankAlgorithmFactory = std::move(factory);
         }
 
-        auto getTankAlgorithmFactory() {
+        auto getTankAlgorithmFactory() const {
             return tankAlgorithmFactory;
         }
 
@@ -51,7 +52,7 @@ class AlgorithmRegistrar {
             playerFactory = std::move(factory);
         }
 
-        auto GetPlayerFactory() {
+        auto getPlayerFactory() const {
             return playerFactory;
         }
 
@@ -102,6 +103,7 @@ class AlgorithmRegistrar {
         }
     };
 
+private:
     std::vector<AlgorithmAndPlayerFactories> algorithms; ///< List of registered algorithms
     static AlgorithmRegistrar registrar; ///< Singleton instance
 
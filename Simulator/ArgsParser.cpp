@@ -1,6 +1,7 @@
 // ArgsParser.cpp
 
 #include "ArgsParser.h"
+#include "CompetitionShard.h"
 #include <iostream>
 #include <algorithm>
 #include <cctype>
@@ -32,9 +33,14 @@ void printUsageAndExit(const std::vector<std::string>& missing,
     // This function prints the usage instructions and exits the program.
     std::cerr << "Usage:\n"
               << "  Comparative mode:\n"
-              << "    -comparative game_map=<file> game_managers_folder=<folder> algorithm1=<file> algorithm2=<file> [num_threads=<n>] [-verbose]\n"
+              << "    -comparative game_map=<file> game_managers_folder=<folder> algorithm1=<file> algorithm2=<file> [num_threads=<n>] [-fast_forward] [-verbose]\n"
               << "  Competition mode:\n"
-              << "    -competition game_maps_folder=<folder> game_manager=<file> algorithms_folder=<folder> [num_threads=<n>] [-verbose]\n\n";
+              << "    -competition game_maps_folder=<folder> game_manager=<file> algorithms_folder=<folder> [num_threads=<n>] [resume=<checkpoint_file>]\n"
+               << "      [game_timeout=<ms>] [action_timeout=<ms>] [timeout_result=loss|tie] [-isolate] [shard=<i>/<n>] [-fast_forward] [-verbose]\n"
+              << "      A game over game_timeout is abandoned: with -isolate its worker process is replaced, otherwise its thread\n"
+              << "      keeps running (and using a core) until the game ends on its own.\n"
+              << "  Merge mode (combines the partial results of all shards):\n"
+              << "    -merge algorithms_folder=<folder> [schedule=<identity>] [-partial_merge]\n\n";
 
     if (!missing.empty()) {
         std::cerr << "Missing arguments:\n";
@@ -62,10 +68,10 @@ ParsedArgs parseArgs(int argc, char* argv[]) {
 
 // Parses the values from argv into args, and fills unsupported vector
 void parseArgsValues(int argc, char* argv[], ParsedArgs& args, std::vector<std::string>& unsupported) {
-    if (argc < 5) {
+    if (argc < 3) {
         throw std::invalid_argument("Not enough arguments provided.");
     }
-    if (argc > 8) {
+    if (argc > 14) {
         throw std::invalid_argument("Too many arguments provided.");
     }
     for (int i = 1; i < argc; ++i) {
@@ -76,6 +82,14 @@ void parseArgsValues(int argc, char* argv[], ParsedArgs& args, std::vector<std::
             args.mode = ParsedArgs::Mode::Comparative;
         } else if (arg == "-competition") {
             args.mode = ParsedArgs::Mode::Competition;
+        } else if (arg == "-merge") {
+            args.mode = ParsedArgs::Mode::Merge;
+        } else if (arg == "-isolate") {
+            args.isolate = true;
+        } else if (arg == "-fast_forward") {
+            args.fast_forward = true;
+        } else if (arg == "-partial_merge") {
+            args.partial_merge = true;
         } else {
             try {
                 auto [key, value] = splitKeyValue(arg);
@@ -90,6 +104,23 @@ void parseArgsValues(int argc, char* argv[], ParsedArgs& args, std::vector<std::
                 else if (key == "game_maps_folder") args.game_maps_folder = value;
                 else if (key == "game_manager") args.game_manager_so = value;
                 else if (key == "algorithms_folder") args.algorithms_folder = value;
+                else if (key == "resume") args.resume_file = value;
+                else if (key == "schedule") args.schedule = value;
+                else if (key == "shard") {
+                    Simulator_206480972_206899163::ShardSpec spec;
+                    if (!Simulator_206480972_206899163::ShardSpec::parse(value, spec))
+                        unsupported.push_back(arg + " (must be i/n with 0 <= i < n)");
+                    args.shard = value;
+                }
+                else if (key == "game_timeout" || key == "action_timeout") {
+                    int timeout_ms = std::stoi(value);
+                    if (timeout_ms < 0)
+                        unsupported.push_back(arg + " (must be >= 0)");
+                    (key == "game_timeout" ? args.game_timeout_ms : args.action_timeout_ms) = timeout_ms;
+                } else if (key == "timeout_result") {
+                    if (value == "tie") args.timeout_is_tie = true;
+                    else if (value != "loss") unsupported.push_back(arg + " (must be loss or tie)");
+                }
                 else unsupported.push_back(key);
             } catch (const std::exception& e) {
                 unsupported.push_back(arg + " (" + e.what() + ")");
@@ -110,8 +141,10 @@ void validateArgs(const ParsedArgs& args, std::vector<std::string>& missing) {
         if (args.game_maps_folder.empty()) missing.push_back("game_maps_folder");
         if (args.game_manager_so.empty()) missing.push_back("game_manager");
         if (args.algorithms_folder.empty()) missing.push_back("algorithms_folder");
+    } else if (args.mode == ParsedArgs::Mode::Merge) {
+        if (args.algorithms_folder.empty()) missing.push_back("algorithms_folder");
     } else {
-        missing.push_back("mode not specified, use (-comparative or -competition)");
+        missing.push_back("mode not specified, use (-comparative, -competition or -merge)");
     }
 }
 
@@ -12,8 +12,9 @@
  */
 
 struct ParsedArgs {
-    enum class Mode { Comparative, Competition };
+    enum class Mode { Comparative, Competition, Merge };
     bool verbose = false;
+    bool fast_forward = false; ///< skip repeated cycles of games stuck until MaxSteps (game managers that support it)
     int num_threads = 1;
     Mode mode;
 
@@ -27,6 +28,16 @@ struct ParsedArgs {
     std::string game_maps_folder;
     std::string game_manager_so;
     std::string algorithms_folder;
+    std::string resume_file; ///< checkpoint file of an interrupted competition run (optional)
+    int game_timeout_ms = 0;    ///< wall-clock budget of a single game, 0 = unlimited
+    int action_timeout_ms = 0;  ///< budget of a single getAction / battle info update, 0 = unlimited
+    bool timeout_is_tie = false; ///< score a budget breach as a tie instead of a loss of the offender
+    bool isolate = false;        ///< run the games in forked worker processes
+    std::string shard;           ///< "i/n": play only shard i of n and write a partial result file (optional)
+
+    // merge mode
+    std::string schedule;        ///< schedule identity of the run to merge, as printed by its shards (optional)
+    bool partial_merge = false;  ///< merge even if some games have no result, e.g. after a shard crashed
 };
 
 /**
@@ -0,0 +1,136 @@
+#include "CompetitionCheckpoint.h"
+#include <cstdint>
+#include <filesystem>
+#include <iomanip>
+#include <iostream>
+#include <iterator>
+#include <sstream>
+
+namespace Simulator_206480972_206899163 {
+
+CompetitionCheckpoint::CompetitionCheckpoint(const std::string& path, size_t num_games, const std::string& schedule) : path(path) {
+    // a file of another schedule is never touched, appending to it would mix game ids of two schedules
+    if (belongsToOther(path, num_games, schedule)) {
+        std::cerr << "Error: checkpoint file '" << path << "' belongs to a different competition, results will not be checkpointed.\n";
+        return;
+    }
+    bool is_new = true;
+    {
+        // a last line cut by a crash is dropped, otherwise the next append would run into it and both would be lost
+        std::ifstream in(path, std::ios::binary);
+        const std::string content((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+        is_new = content.empty();
+        const size_t complete = content.rfind('\n') == std::string::npos ? 0 : content.rfind('\n') + 1;
+        if (!is_new && complete != content.size()) {
+            in.close();
+            std::error_code error;
+            std::filesystem::resize_file(path, complete, error);
+            if (error) {
+                std::cerr << "Error: could not repair checkpoint file '" << path << "', results will not be checkpointed.\n";
+                return;
+            }
+            is_new = complete == 0;
+        }
+    }
+    out.open(path, std::ios::out | std::ios::app);
+    if (!out) {
+        std::cerr << "Error: could not open checkpoint file '" << path << "', results will not be checkpointed.\n";
+        return;
+    }
+    if (is_new) {
+        out << header(num_games, schedule) << "\n";
+        out.flush();
+    }
+}
+
+bool CompetitionCheckpoint::belongsToOther(const std::string& path, size_t num_games, const std::string& schedule) {
+    // This function compares the first line of a non-empty file with the header of the schedule; a header cut by
+    // a crash before its newline counts as an empty file
+    std::ifstream in(path);
+    std::string first_line;
+    if (!in || !std::getline(in, first_line) || in.eof()) {
+        return false;
+    }
+    return first_line != header(num_games, schedule);
+}
+
+std::string CompetitionCheckpoint::header(size_t num_games, const std::string& schedule) {
+    // This function returns the first line of the checkpoint file
+    return "checkpoint games=" + std::to_string(num_games) + " schedule=" + schedule;
+}
+
+std::string CompetitionCheckpoint::scheduleIdentity(const std::string& game_manager, const std::vector<std::string>& algorithms,
+                                                    const std::vector<std::string>& maps) {
+    // This function hashes the parts with 64 bit FNV-1a; the separators keep different splits of the same text apart
+    std::uint64_t hash = 14695981039346656037ull;
+    auto add = [&hash](const std::string& text, char separator) {
+        for (unsigned char c : text) {
+            hash = (hash ^ c) * 1099511628211ull;
+        }
+        hash = (hash ^ static_cast<unsigned char>(separator)) * 1099511628211ull;
+    };
+    add(game_manager, '\n');
+    for (const auto& algorithm : algorithms) {
+        add(algorithm, '\n');
+    }
+    add("", '\0');
+    for (const auto& map : maps) {
+        add(map, '\n');
+    }
+    std::ostringstream text;
+    text << std::hex << std::setw(16) << std::setfill('0') << hash;
+    return text.str();
+}
+
+std::vector<CheckpointEntry> CompetitionCheckpoint::load(const std::string& path, size_t num_games, const std::string& schedule) {
+    // This function reads the recorded games, ignoring a file of another schedule and a truncated last line
+    std::vector<CheckpointEntry> entries;
+    std::ifstream in(path);
+    if (!in) {
+        std::cerr << "Resume file '" << path << "' could not be opened, starting from scratch.\n";
+        return entries;
+    }
+    std::string line;
+    if (!std::getline(in, line) || line != header(num_games, schedule)) {
+        std::cerr << "Resume file '" << path << "' belongs to a different competition, starting from scratch.\n";
+        return entries;
+    }
+    while (std::getline(in, line)) {
+        std::istringstream fields(line);
+        size_t game_id, rounds;
+        int winner, reason;
+        if (!(fields >> game_id >> winner >> reason >> rounds)) {
+            continue; // a line cut by a crash
+        }
+        if (game_id >= num_games || winner < 0 || winner > 2 ||
+            reason < GameResult::ALL_TANKS_DEAD || reason > GameResult::ZERO_SHELLS) {
+            continue;
+        }
+        entries.push_back(CheckpointEntry{game_id, winner, static_cast<GameResult::Reason>(reason), rounds});
+    }
+    return entries;
+}
+
+void CompetitionCheckpoint::append(const CheckpointEntry& entry) {
+    // This function appends a single line and flushes it, so a crash loses at most the games in flight
+    std::ostringstream line;
+    line << entry.game_id << " " << entry.winner << " " << static_cast<int>(entry.reason) << " " << entry.rounds << "\n";
+    std::lock_guard<std::mutex> lock(mutex); // the stream state is written by the other workers' appends too
+    if (!out) {
+        return;
+    }
+    out << line.str();
+    out.flush();
+}
+
+const std::string& CompetitionCheckpoint::getPath() const {
+    // This function returns the path of the checkpoint file
+    return path;
+}
+
+bool CompetitionCheckpoint::isOpen() const {
+    // This function returns whether the checkpoint file could be opened
+    return static_cast<bool>(out);
+}
+
+} // namespace Simulator_206480972_206899163
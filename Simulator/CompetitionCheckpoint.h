@@ -0,0 +1,112 @@
+#pragma once
+#include <cstddef>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "../common/GameResult.h"
+
+/**
+ * @file CompetitionCheckpoint.h
+ * @brief Declares the append-only checkpoint file of a competition run.
+ */
+
+namespace Simulator_206480972_206899163 {
+
+/**
+ * @struct CheckpointEntry
+ * @brief A finished game as recorded in the checkpoint file.
+ */
+struct CheckpointEntry {
+    size_t game_id;             ///< Index of the game in the competition schedule
+    int winner;                 ///< 0 = tie, 1 or 2 = winning player
+    GameResult::Reason reason;  ///< Why the game ended
+    size_t rounds;              ///< Number of rounds played
+};
+
+/**
+ * @class CompetitionCheckpoint
+ * @brief Appends one line per finished game to a checkpoint file, so that an interrupted run can resume.
+ *
+ * The file starts with a header holding the number of scheduled games and the identity of the schedule (see
+ * scheduleIdentity()), followed by lines of the form "<game_id> <winner> <reason> <rounds>". Every line is flushed
+ * as soon as the game finishes. A file whose header does not match the current schedule is never resumed, since
+ * its game ids may refer to other games.
+ */
+class CompetitionCheckpoint {
+public:
+    /**
+     * @brief Opens the checkpoint file for appending, writing the header if the file is new or empty. A file of
+     *        another schedule is left as it is and nothing is checkpointed (see belongsToOther). A last line without
+     *        a newline, cut by a crash, is removed first.
+     * @param path Path of the checkpoint file.
+     * @param num_games Number of scheduled games in the competition.
+     * @param schedule Identity of the schedule, see scheduleIdentity().
+     */
+    CompetitionCheckpoint(const std::string& path, size_t num_games, const std::string& schedule);
+
+    // Rule of 5
+    CompetitionCheckpoint(const CompetitionCheckpoint&) = delete;
+    CompetitionCheckpoint& operator=(const CompetitionCheckpoint&) = delete;
+    CompetitionCheckpoint(CompetitionCheckpoint&&) = delete;
+    CompetitionCheckpoint& operator=(CompetitionCheckpoint&&) = delete;
+    ~CompetitionCheckpoint() = default;
+
+    /**
+     * @brief Returns the identity of a competition schedule: a hash of the game manager, the algorithms and the maps,
+     *        each given as "<name> <content hash>", in schedule order.
+     * @param game_manager The game manager.
+     * @param algorithms The algorithms, in the order their indices are assigned.
+     * @param maps The maps, in the order their indices are assigned.
+     * @return The identity as 16 hex digits.
+     */
+    static std::string scheduleIdentity(const std::string& game_manager, const std::vector<std::string>& algorithms,
+                                        const std::vector<std::string>& maps);
+
+    /**
+     * @brief Returns whether the file has a complete first line, but it is not the header of the schedule.
+     * @param path Path of the checkpoint file.
+     * @param num_games Number of scheduled games in the current competition.
+     * @param schedule Identity of the current schedule, see scheduleIdentity().
+     */
+    static bool belongsToOther(const std::string& path, size_t num_games, const std::string& schedule);
+
+    /**
+     * @brief Reads the finished games from an existing checkpoint file.
+     * @param path Path of the checkpoint file.
+     * @param num_games Number of scheduled games in the current competition.
+     * @param schedule Identity of the current schedule, see scheduleIdentity().
+     * @return The recorded games, empty if the file is missing or belongs to a different schedule.
+     */
+    static std::vector<CheckpointEntry> load(const std::string& path, size_t num_games, const std::string& schedule);
+
+    /**
+     * @brief Appends a finished game and flushes it to disk. Safe to call from several workers.
+     * @param entry The finished game.
+     */
+    void append(const CheckpointEntry& entry);
+
+    /**
+     * @brief Returns the path of the checkpoint file.
+     */
+    const std::string& getPath() const;
+
+    /**
+     * @brief Returns whether the checkpoint file could be opened.
+     */
+    bool isOpen() const;
+
+private:
+    std::string path;   ///< Path of the checkpoint file
+    std::ofstream out;  ///< Append stream
+    std::mutex mutex;   ///< Serializes appends of concurrently finishing games
+
+    /**
+     * @brief Returns the header line of a schedule.
+     * @param num_games Number of scheduled games.
+     * @param schedule Identity of the schedule.
+     */
+    static std::string header(size_t num_games, const std::string& schedule);
+};
+
+} // namespace Simulator_206480972_206899163
@@ -0,0 +1,60 @@
+#include "CompetitionScoreTable.h"
+#include <algorithm>
+
+namespace Simulator_206480972_206899163 {
+
+CompetitionScoreTable::CompetitionScoreTable(size_t num_games, size_t num_algorithms)
+    : records(num_games), scores(num_algorithms) {}
+
+void CompetitionScoreTable::recordGame(size_t game_id, int player1_algorithm, int player2_algorithm,
+                                       int winner, GameResult::Reason reason, size_t rounds, long long duration_ns, bool forfeited) {
+    // This function fills the game's own slot and adds the scores: 3 for a win, 1 each for a tie
+    GameRecord& record = records[game_id];
+    record.player1_algorithm = player1_algorithm;
+    record.player2_algorithm = player2_algorithm;
+    record.winner = winner;
+    record.reason = reason;
+    record.rounds = rounds;
+    record.duration_ns = duration_ns;
+    record.finished = true;
+    record.forfeited = forfeited;
+    if (winner == 1) {
+        scores[player1_algorithm].fetch_add(3, std::memory_order_relaxed);
+    } else if (winner == 2) {
+        scores[player2_algorithm].fetch_add(3, std::memory_order_relaxed);
+    } else {
+        scores[player1_algorithm].fetch_add(1, std::memory_order_relaxed);
+        scores[player2_algorithm].fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+const GameRecord& CompetitionScoreTable::getRecord(size_t game_id) const {
+    // This function returns the record of a game
+    return records[game_id];
+}
+
+size_t CompetitionScoreTable::gameCount() const {
+    // This function returns the number of games in the table
+    return records.size();
+}
+
+long long CompetitionScoreTable::getScore(size_t algorithm) const {
+    // This function returns the total score of an algorithm
+    return scores[algorithm].load(std::memory_order_relaxed);
+}
+
+std::vector<std::pair<size_t, long long>> CompetitionScoreTable::sortedScores() const {
+    // This function returns the algorithms sorted by descending score (ties by index, for determinism)
+    std::vector<std::pair<size_t, long long>> sorted;
+    sorted.reserve(scores.size());
+    for (size_t i = 0; i < scores.size(); ++i) {
+        sorted.emplace_back(i, getScore(i));
+    }
+    std::sort(sorted.begin(), sorted.end(), [](const auto& a, const auto& b) {
+        if (a.second != b.second) return a.second > b.second;
+        return a.first < b.first;
+    });
+    return sorted;
+}
+
+} // namespace Simulator_206480972_206899163
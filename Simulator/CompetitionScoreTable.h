@@ -0,0 +1,91 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <string>
+#include <utility>
+#include <vector>
+#include "../common/GameResult.h"
+
+/**
+ * @file CompetitionScoreTable.h
+ * @brief Declares the preallocated result table of a competition run.
+ */
+
+namespace Simulator_206480972_206899163 {
+
+/**
+ * @struct GameRecord
+ * @brief The outcome of a single competition game, as stored in the result table.
+ */
+struct GameRecord {
+    int player1_algorithm = -1;               ///< Algorithm index playing as player 1
+    int player2_algorithm = -1;               ///< Algorithm index playing as player 2
+    int winner = 0;                           ///< 0 = tie, 1 or 2 = winning player
+    GameResult::Reason reason = GameResult::MAX_STEPS; ///< Why the game ended
+    size_t rounds = 0;                        ///< Number of rounds played
+    long long duration_ns = 0;                ///< Measured wall time of the game, 0 if not measured
+    bool finished = false;                    ///< True once the game result was recorded
+    bool forfeited = false;                   ///< True if a budget breach or a crash decided the game
+    bool abandoned = false;                   ///< True if the game exceeded its wall-clock budget and still runs
+};
+
+/**
+ * @class CompetitionScoreTable
+ * @brief Result table of a competition, allocated up front since every game is known before the run.
+ *
+ * Each worker writes only the slot of its own game id, so recording a game needs no lock.
+ * Algorithm scores (3 points per win, 1 per tie) are accumulated with atomic additions.
+ * The table is read by the main thread only after all workers joined.
+ */
+class CompetitionScoreTable {
+public:
+    /**
+     * @brief Allocates the table.
+     * @param num_games Number of scheduled games.
+     * @param num_algorithms Number of competing algorithms.
+     */
+    CompetitionScoreTable(size_t num_games, size_t num_algorithms);
+
+    /**
+     * @brief Records the result of a game into its slot and adds the scores. Safe to call concurrently
+     *        for different game ids.
+     * @param game_id Index of the game.
+     * @param player1_algorithm Algorithm index playing as player 1.
+     * @param player2_algorithm Algorithm index playing as player 2.
+     * @param winner 0 for a tie, 1 or 2 for the winning player.
+     * @param reason Why the game ended.
+     * @param rounds Number of rounds played.
+     * @param duration_ns Measured wall time of the game, 0 if the game was not run in this process.
+     * @param forfeited True if a budget breach or a crash decided the game.
+     */
+    void recordGame(size_t game_id, int player1_algorithm, int player2_algorithm,
+                    int winner, GameResult::Reason reason, size_t rounds, long long duration_ns, bool forfeited = false);
+
+    /**
+     * @brief Returns the record of a game.
+     * @param game_id Index of the game.
+     */
+    const GameRecord& getRecord(size_t game_id) const;
+
+    /**
+     * @brief Returns the number of games in the table.
+     */
+    size_t gameCount() const;
+
+    /**
+     * @brief Returns the total score of an algorithm.
+     * @param algorithm Index of the algorithm.
+     */
+    long long getScore(size_t algorithm) const;
+
+    /**
+     * @brief Returns (algorithm index, score) pairs sorted by descending score.
+     */
+    std::vector<std::pair<size_t, long long>> sortedScores() const;
+
+private:
+    std::vector<GameRecord> records;              ///< One slot per game id
+    std::vector<std::atomic<long long>> scores;   ///< Total score per algorithm
+};
+
+} // namespace Simulator_206480972_206899163
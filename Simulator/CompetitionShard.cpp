@@ -0,0 +1,316 @@
+#include "CompetitionShard.h"
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <set>
+#include <sstream>
+#include <tuple>
+
+namespace Simulator_206480972_206899163 {
+
+namespace {
+
+const std::string kPartialPrefix = "competition_partial_"; ///< File name prefix of partial result files
+
+/**
+ * @brief A parsed partial result file.
+ */
+struct PartialFile {
+    std::filesystem::path path;              ///< Where the file was read from
+    ShardSpec spec;                          ///< The shard that wrote the file
+    size_t num_games = 0;                    ///< Number of games of the whole competition
+    std::string schedule;                    ///< Identity of the schedule, see CompetitionCheckpoint::scheduleIdentity
+    std::string game_maps_folder;            ///< Maps folder of the competition
+    std::string game_manager_so;             ///< Game manager of the competition
+    std::vector<std::string> algorithms;     ///< Algorithm names, by index
+    std::vector<GameRecord> games;           ///< Finished games of the shard
+    std::vector<size_t> game_ids;            ///< Ids of the finished games, parallel to games
+};
+
+bool readValue(std::istream& in, const std::string& key, std::string& value) {
+    // This function reads a "key=value" line
+    std::string line;
+    if (!std::getline(in, line) || line.rfind(key + "=", 0) != 0) {
+        return false;
+    }
+    value = line.substr(key.size() + 1);
+    return true;
+}
+
+bool readPartial(const std::filesystem::path& path, PartialFile& partial, std::string& error) {
+    // This function parses a partial result file
+    std::ifstream in(path);
+    std::string line;
+    if (!in || !std::getline(in, line)) {
+        error = "could not read " + path.string();
+        return false;
+    }
+    std::istringstream header(line);
+    std::string magic, shard_field, games_field, schedule_field;
+    header >> magic >> shard_field >> games_field >> schedule_field;
+    partial.path = path;
+    if (magic != "competition_partial" || shard_field.rfind("shard=", 0) != 0 || games_field.rfind("games=", 0) != 0 ||
+        !ShardSpec::parse(shard_field.substr(6), partial.spec)) {
+        error = path.string() + " is not a partial result file";
+        return false;
+    }
+    // files of older runs have no schedule identity, they never match a current one
+    if (schedule_field.rfind("schedule=", 0) == 0) {
+        partial.schedule = schedule_field.substr(9);
+    }
+    try {
+        partial.num_games = std::stoul(games_field.substr(6));
+    } catch (const std::exception&) {
+        error = path.string() + " has an invalid header";
+        return false;
+    }
+    if (!readValue(in, "game_maps_folder", partial.game_maps_folder) || !readValue(in, "game_manager", partial.game_manager_so)) {
+        error = path.string() + " has an invalid header";
+        return false;
+    }
+    while (std::getline(in, line)) {
+        std::istringstream fields(line);
+        std::string kind;
+        fields >> kind;
+        if (kind == "algorithm") {
+            size_t index;
+            std::string name;
+            if (!(fields >> index) || index != partial.algorithms.size() || !std::getline(fields >> std::ws, name)) {
+                error = path.string() + " has an invalid algorithm line: " + line;
+                return false;
+            }
+            partial.algorithms.push_back(name);
+        } else if (kind == "game") {
+            size_t game_id, rounds;
+            int player1, player2, winner, reason;
+            if (!(fields >> game_id >> player1 >> player2 >> winner >> reason >> rounds) ||
+                game_id >= partial.num_games || !partial.spec.contains(game_id) ||
+                player1 < 0 || player2 < 0 || static_cast<size_t>(std::max(player1, player2)) >= partial.algorithms.size() ||
+                winner < 0 || winner > 2 || reason < GameResult::ALL_TANKS_DEAD || reason > GameResult::ZERO_SHELLS) {
+                error = path.string() + " has an invalid game line: " + line;
+                return false;
+            }
+            GameRecord record;
+            record.player1_algorithm = player1;
+            record.player2_algorithm = player2;
+            record.winner = winner;
+            record.reason = static_cast<GameResult::Reason>(reason);
+            record.rounds = rounds;
+            record.finished = true;
+            partial.games.push_back(record);
+            partial.game_ids.push_back(game_id);
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Partial files of the same run: the same schedule split into the same number of shards.
+ */
+struct PartialGroup {
+    std::string schedule;                            ///< Identity of the schedule
+    size_t shard_count = 0;                          ///< Number of shards of the run
+    std::vector<size_t> members;                     ///< Indices of the files of the group
+    std::filesystem::file_time_type newest = std::filesystem::file_time_type::min(); ///< Modification time of its newest file
+};
+
+} // namespace
+
+bool ShardSpec::parse(const std::string& text, ShardSpec& spec) {
+    // This function parses "i/n"
+    size_t slash = text.find('/');
+    if (slash == std::string::npos) {
+        return false;
+    }
+    try {
+        size_t used_index = 0, used_count = 0;
+        long long index = std::stoll(text.substr(0, slash), &used_index);
+        long long count = std::stoll(text.substr(slash + 1), &used_count);
+        if (used_index != slash || used_count != text.size() - slash - 1 || count < 1 || index < 0 || index >= count) {
+            return false;
+        }
+        spec.index = static_cast<size_t>(index);
+        spec.count = static_cast<size_t>(count);
+        return true;
+    } catch (const std::exception&) {
+        return false;
+    }
+}
+
+std::string CompetitionShard::partialFileName(const ShardSpec& spec) {
+    // This function returns the deterministic file name of a shard, so that shards sharing a folder never collide
+    return kPartialPrefix + std::to_string(spec.index) + "_of_" + std::to_string(spec.count) + ".txt";
+}
+
+bool CompetitionShard::writePartial(const std::string& algorithms_folder, const ShardSpec& spec,
+                                    const std::string& game_maps_folder, const std::string& game_manager_so,
+                                    const std::vector<std::string>& algorithm_names, const std::string& schedule,
+                                    const CompetitionScoreTable& score_table) {
+    // This function writes the partial file through a temporary file, so the merge never sees a half-written file
+    std::ostringstream content;
+    content << "competition_partial shard=" << spec.index << "/" << spec.count << " games=" << score_table.gameCount()
+            << " schedule=" << schedule << "\n";
+    content << "game_maps_folder=" << game_maps_folder << "\n";
+    content << "game_manager=" << game_manager_so << "\n";
+    for (size_t i = 0; i < algorithm_names.size(); ++i) {
+        content << "algorithm " << i << " " << algorithm_names[i] << "\n";
+    }
+    for (size_t game_id = 0; game_id < score_table.gameCount(); ++game_id) {
+        const GameRecord& record = score_table.getRecord(game_id);
+        if (!spec.contains(game_id) || !record.finished) {
+            continue;
+        }
+        content << "game " << game_id << " " << record.player1_algorithm << " " << record.player2_algorithm << " "
+                << record.winner << " " << static_cast<int>(record.reason) << " " << record.rounds << "\n";
+    }
+    const std::filesystem::path path = std::filesystem::path(algorithms_folder) / partialFileName(spec);
+    const std::filesystem::path temporary = path.string() + ".tmp";
+    {
+        std::ofstream out(temporary);
+        if (!out || !(out << content.str()) || !out.flush()) {
+            std::cerr << "Error: could not write partial result file '" << temporary.string() << "'.\n";
+            return false;
+        }
+    }
+    std::error_code error;
+    std::filesystem::rename(temporary, path, error);
+    if (error) {
+        std::cerr << "Error: could not write partial result file '" << path.string() << "': " << error.message() << "\n";
+        return false;
+    }
+    std::cout << "Competition partial results: " << path.string() << " (schedule " << schedule << ")" << std::endl;
+    return true;
+}
+
+bool CompetitionShard::merge(const std::string& algorithms_folder, const std::string& schedule, std::string& game_maps_folder,
+                             std::string& game_manager_so, std::vector<std::pair<std::string, long long>>& scores,
+                             bool allow_missing_games, std::string& error) {
+    // This function picks the partial files of one run, checks that they form a complete competition and sums their scores
+    std::vector<std::filesystem::path> paths;
+    std::error_code listing_error;
+    for (const auto& entry : std::filesystem::directory_iterator(algorithms_folder, listing_error)) {
+        const std::string name = entry.path().filename().string();
+        if (entry.is_regular_file() && name.rfind(kPartialPrefix, 0) == 0 && entry.path().extension() == ".txt") {
+            paths.push_back(entry.path());
+        }
+    }
+    if (listing_error) {
+        error = "could not list " + algorithms_folder + ": " + listing_error.message();
+        return false;
+    }
+    if (paths.empty()) {
+        error = "no partial result files in " + algorithms_folder;
+        return false;
+    }
+    std::sort(paths.begin(), paths.end());
+
+    std::vector<PartialFile> partials(paths.size());
+    for (size_t i = 0; i < paths.size(); ++i) {
+        if (!readPartial(paths[i], partials[i], error)) {
+            return false;
+        }
+    }
+
+    // files of other runs (another schedule, or the same one split differently) may be left in the folder. the run
+    // merged is the most recently written one, of the schedule named on the command line if any; if it is missing
+    // a shard the merge fails below rather than falling back to an older run.
+    std::vector<PartialGroup> groups;
+    for (size_t i = 0; i < partials.size(); ++i) {
+        const PartialFile& partial = partials[i];
+        if (!schedule.empty() && partial.schedule != schedule) {
+            continue;
+        }
+        auto group = std::find_if(groups.begin(), groups.end(), [&partial](const PartialGroup& g) {
+            return g.schedule == partial.schedule && g.shard_count == partial.spec.count;
+        });
+        if (group == groups.end()) {
+            groups.push_back(PartialGroup{partial.schedule, partial.spec.count, {}});
+            group = std::prev(groups.end());
+        }
+        group->members.push_back(i);
+        std::error_code time_error;
+        group->newest = std::max(group->newest, std::filesystem::last_write_time(partial.path, time_error));
+    }
+    if (groups.empty()) {
+        error = "no partial result files of schedule " + schedule + " in " + algorithms_folder;
+        return false;
+    }
+    const PartialGroup& chosen = *std::max_element(groups.begin(), groups.end(), [](const PartialGroup& a, const PartialGroup& b) {
+        return std::make_tuple(a.newest, a.members.size()) < std::make_tuple(b.newest, b.members.size());
+    });
+    std::vector<PartialFile> selected;
+    for (size_t i = 0; i < partials.size(); ++i) {
+        if (std::find(chosen.members.begin(), chosen.members.end(), i) != chosen.members.end()) {
+            selected.push_back(std::move(partials[i]));
+        } else {
+            std::cerr << "Skipping " << partials[i].path.string() << ": it belongs to another run (schedule "
+                      << (partials[i].schedule.empty() ? "unknown" : partials[i].schedule) << ", " << partials[i].spec.count
+                      << " shards) than the one merged (schedule " << chosen.schedule << ", " << chosen.shard_count << " shards).\n";
+        }
+    }
+    partials = std::move(selected);
+
+    const PartialFile& first = partials.front();
+    std::set<size_t> shards;
+    for (const PartialFile& partial : partials) {
+        if (partial.spec.count != first.spec.count || partial.num_games != first.num_games ||
+            partial.game_maps_folder != first.game_maps_folder || partial.game_manager_so != first.game_manager_so ||
+            partial.algorithms != first.algorithms) {
+            error = "partial result files belong to different competitions";
+            return false;
+        }
+        if (!shards.insert(partial.spec.index).second) {
+            error = "shard " + std::to_string(partial.spec.index) + " appears twice";
+            return false;
+        }
+    }
+    if (shards.size() != first.spec.count) {
+        error = "only " + std::to_string(shards.size()) + " of " + std::to_string(first.spec.count) + " shards are present";
+        return false;
+    }
+
+    // score like a single run: every game once, 3 points for a win and 1 point each for a tie
+    std::vector<long long> totals(first.algorithms.size(), 0);
+    std::set<size_t> counted;
+    for (const PartialFile& partial : partials) {
+        for (size_t i = 0; i < partial.games.size(); ++i) {
+            if (!counted.insert(partial.game_ids[i]).second) {
+                continue; // a game written twice is still scored once
+            }
+            const GameRecord& record = partial.games[i];
+            if (record.winner == 1) {
+                totals[record.player1_algorithm] += 3;
+            } else if (record.winner == 2) {
+                totals[record.player2_algorithm] += 3;
+            } else {
+                totals[record.player1_algorithm] += 1;
+                totals[record.player2_algorithm] += 1;
+            }
+        }
+    }
+    // a shard that stopped early wrote only part of its games; its ranking is only published when asked for
+    if (counted.size() != first.num_games) {
+        const std::string missing = std::to_string(first.num_games - counted.size()) + " of " +
+                                    std::to_string(first.num_games) + " games have no result in the partial files";
+        if (!allow_missing_games) {
+            error = missing + " (use -partial_merge to merge them anyway)";
+            return false;
+        }
+        std::cerr << "Warning: " << missing << ", merging the rest.\n";
+    }
+    std::vector<size_t> order(totals.size());
+    for (size_t i = 0; i < order.size(); ++i) {
+        order[i] = i;
+    }
+    std::stable_sort(order.begin(), order.end(), [&totals](size_t a, size_t b) { return totals[a] > totals[b]; });
+    scores.clear();
+    for (size_t algorithm : order) {
+        scores.emplace_back(first.algorithms[algorithm], totals[algorithm]);
+    }
+    game_maps_folder = first.game_maps_folder;
+    game_manager_so = first.game_manager_so;
+    return true;
+}
+
+} // namespace Simulator_206480972_206899163
@@ -0,0 +1,96 @@
+#pragma once
+#include <cstddef>
+#include <string>
+#include <utility>
+#include <vector>
+#include "CompetitionScoreTable.h"
+
+/**
+ * @file CompetitionShard.h
+ * @brief Declares the splitting of a competition into shards and the merging of their partial results.
+ */
+
+namespace Simulator_206480972_206899163 {
+
+/**
+ * @struct ShardSpec
+ * @brief Selects the games of one shard out of n: shard i plays every game whose id is i modulo n.
+ *        Game ids are stable for the same folders, so every process selects the same split.
+ */
+struct ShardSpec {
+    size_t index = 0; ///< Index of this shard, 0 <= index < count
+    size_t count = 1; ///< Number of shards, 1 = no sharding
+
+    /**
+     * @brief Returns whether the competition is split into several shards.
+     */
+    bool active() const { return count > 1; }
+
+    /**
+     * @brief Returns whether the game belongs to this shard.
+     * @param game_id Id of the game.
+     */
+    bool contains(size_t game_id) const { return game_id % count == index; }
+
+    /**
+     * @brief Parses "i/n".
+     * @param text The text to parse.
+     * @param spec Output parameter for the parsed shard.
+     * @return True if the text is a valid shard (n >= 1, i < n).
+     */
+    static bool parse(const std::string& text, ShardSpec& spec);
+};
+
+/**
+ * @class CompetitionShard
+ * @brief Writes the partial result file of a shard and merges the partial files into the final scores.
+ *
+ * A partial file is named competition_partial_<i>_of_<n>.txt and holds a header with the shard, the number
+ * of games, the schedule identity (see CompetitionCheckpoint::scheduleIdentity), the maps folder and the game
+ * manager, one "algorithm <index> <name>" line per algorithm and one
+ * "game <id> <player1> <player2> <winner> <reason> <rounds>" line per finished game of the shard.
+ * Merging picks the files of a single run, which requires all n partial files of the same schedule, and scores
+ * them like a single run. Files of other runs left in the folder are skipped with a message.
+ */
+class CompetitionShard {
+public:
+    /**
+     * @brief Returns the file name of the partial result file of a shard.
+     * @param spec The shard.
+     */
+    static std::string partialFileName(const ShardSpec& spec);
+
+    /**
+     * @brief Writes the partial result file of a shard into the algorithms folder.
+     * @param algorithms_folder Folder where the file is created.
+     * @param spec The shard.
+     * @param game_maps_folder The game maps folder, as given.
+     * @param game_manager_so Path of the game manager .so, as given.
+     * @param algorithm_names Names of all algorithms, by algorithm index.
+     * @param schedule Identity of the schedule, so that files of a run with other libraries or maps are never merged.
+     * @param score_table The result table of the competition.
+     * @return True if the file was written.
+     */
+    static bool writePartial(const std::string& algorithms_folder, const ShardSpec& spec,
+                             const std::string& game_maps_folder, const std::string& game_manager_so,
+                             const std::vector<std::string>& algorithm_names, const std::string& schedule,
+                             const CompetitionScoreTable& score_table);
+
+    /**
+     * @brief Reads the partial result files of one run from the folder and sums the scores of every algorithm.
+     *        The run is the most recently written one, of the given schedule if any; the files of other runs are skipped.
+     * @param algorithms_folder Folder holding the partial files.
+     * @param schedule Identity of the schedule to merge, empty for any.
+     * @param game_maps_folder Output parameter for the maps folder of the competition.
+     * @param game_manager_so Output parameter for the game manager of the competition.
+     * @param scores Output parameter for the (algorithm name, total score) pairs, sorted by descending score.
+     * @param allow_missing_games Merge even if some games have no result (a shard stopped early); fail otherwise.
+     * @param error Output parameter for the reason of a failure.
+     * @return True if a complete set of partial files was merged.
+     */
+    static bool merge(const std::string& algorithms_folder, const std::string& schedule, std::string& game_maps_folder,
+                      std::string& game_manager_so, std::vector<std::pair<std::string, long long>>& scores,
+                      bool allow_missing_games, std::string& error);
+};
+
+} // namespace Simulator_206480972_206899163
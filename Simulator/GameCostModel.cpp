@@ -0,0 +1,111 @@
+#include "GameCostModel.h"
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <unistd.h>
+
+namespace Simulator_206480972_206899163 {
+
+GameCostModel::GameCostModel(const std::string& history_path) : history_path(history_path) {
+    // A missing or partially broken history file simply leaves algorithms without history
+    load(history_path, history);
+    updateDefault();
+}
+
+void GameCostModel::load(const std::string& path, std::map<std::string, AlgorithmHistory>& history) {
+    // This function reads one "<name> <ns_per_unit> <samples>" line per algorithm
+    std::ifstream in(path);
+    std::string line;
+    while (in && std::getline(in, line)) {
+        std::istringstream fields(line);
+        std::string name;
+        AlgorithmHistory entry;
+        if (fields >> name >> entry.ns_per_unit >> entry.samples && entry.ns_per_unit > 0) {
+            history[name] = entry;
+        }
+    }
+}
+
+double GameCostModel::stepUnits(const MapData& map) {
+    // This function returns rows x cols x tanks, the work of a single step on the map
+    size_t tanks = 0;
+    for (const auto& row : map.grid) {
+        tanks += static_cast<size_t>(std::count_if(row.begin(), row.end(), [](char c) { return c == '1' || c == '2'; }));
+    }
+    return static_cast<double>(map.length) * map.height * std::max<size_t>(tanks, 1);
+}
+
+double GameCostModel::estimate(const MapData& map, const std::string& algorithm1, const std::string& algorithm2) const {
+    // This function estimates a game as max_steps x step units x the average cost of both algorithms
+    double ns_per_unit = (nsPerUnit(algorithm1) + nsPerUnit(algorithm2)) / 2;
+    return static_cast<double>(map.max_steps) * stepUnits(map) * ns_per_unit;
+}
+
+void GameCostModel::addSample(const std::string& algorithm, double ns_per_unit) {
+    // This function folds a measurement into a moving average that favours recent runs
+    if (ns_per_unit <= 0) {
+        return;
+    }
+    AlgorithmHistory& entry = history[algorithm];
+    measured.insert(algorithm);
+    entry.samples++;
+    double weight = std::max(1.0 / static_cast<double>(entry.samples), 0.2);
+    entry.ns_per_unit += (ns_per_unit - entry.ns_per_unit) * weight;
+    updateDefault();
+}
+
+bool GameCostModel::save() const {
+    // This function merges this run's measurements into the file on disk and replaces it through a temporary file
+    std::map<std::string, AlgorithmHistory> merged;
+    load(history_path, merged);
+    for (const auto& [name, entry] : history) {
+        if (measured.count(name) > 0 || merged.count(name) == 0) {
+            merged[name] = entry;
+        }
+    }
+    const std::string temporary = history_path + ".tmp" + std::to_string(getpid());
+    {
+        std::ofstream out(temporary, std::ios::out | std::ios::trunc);
+        if (!out) {
+            return false;
+        }
+        for (const auto& [name, entry] : merged) {
+            out << name << " " << entry.ns_per_unit << " " << entry.samples << "\n";
+        }
+        if (!out.flush()) {
+            out.close();
+            std::error_code error;
+            std::filesystem::remove(temporary, error);
+            return false;
+        }
+    }
+    std::error_code error;
+    std::filesystem::rename(temporary, history_path, error);
+    if (error) {
+        std::filesystem::remove(temporary, error);
+        return false;
+    }
+    return true;
+}
+
+double GameCostModel::nsPerUnit(const std::string& algorithm) const {
+    // This function returns the measured cost of the algorithm, or the default one
+    auto it = history.find(algorithm);
+    return it != history.end() ? it->second.ns_per_unit : default_ns_per_unit;
+}
+
+void GameCostModel::updateDefault() {
+    // This function sets the default cost to the average of the known algorithms
+    if (history.empty()) {
+        default_ns_per_unit = 1;
+        return;
+    }
+    double sum = 0;
+    for (const auto& [name, entry] : history) {
+        sum += entry.ns_per_unit;
+    }
+    default_ns_per_unit = sum / static_cast<double>(history.size());
+}
+
+} // namespace Simulator_206480972_206899163
@@ -0,0 +1,95 @@
+#pragma once
+#include <cstddef>
+#include <map>
+#include <set>
+#include <string>
+#include "../UserCommon/MapData.h"
+
+/**
+ * @file GameCostModel.h
+ * @brief Declares the cost estimation used to schedule the longest competition games first.
+ */
+
+namespace Simulator_206480972_206899163 {
+
+/**
+ * @class GameCostModel
+ * @brief Estimates how long a game will run, from the map and from per-algorithm timings of earlier runs.
+ *
+ * The work of a game is modelled in "units": max_steps x rows x cols x tanks. Each algorithm has a
+ * measured cost in nanoseconds per unit, kept in a small history file (one "<name> <ns_per_unit> <samples>"
+ * line per algorithm). An algorithm without history gets the average of the known ones (or 1 if none),
+ * so estimates of different games stay comparable and can be sorted. Several runs (e.g. shards) may share the
+ * history file: save() merges with the file on disk and replaces it atomically.
+ */
+class GameCostModel {
+public:
+    /**
+     * @brief Constructs the model and loads the history file, if it exists.
+     * @param history_path Path of the history file.
+     */
+    explicit GameCostModel(const std::string& history_path);
+
+    /**
+     * @brief Returns the amount of work in a single game step on the map: rows x cols x tanks.
+     * @param map The parsed map.
+     */
+    static double stepUnits(const MapData& map);
+
+    /**
+     * @brief Estimates the cost of a full game on the map between two algorithms.
+     * @param map The parsed map.
+     * @param algorithm1 Name of the algorithm playing as player 1.
+     * @param algorithm2 Name of the algorithm playing as player 2.
+     * @return Estimated cost, in nanoseconds when history is available.
+     */
+    double estimate(const MapData& map, const std::string& algorithm1, const std::string& algorithm2) const;
+
+    /**
+     * @brief Adds a measured game to the history of an algorithm.
+     * @param algorithm Name of the algorithm.
+     * @param ns_per_unit Measured nanoseconds per unit of work.
+     */
+    void addSample(const std::string& algorithm, double ns_per_unit);
+
+    /**
+     * @brief Writes the history file through a temporary file. Algorithms this run measured get their new history,
+     *        the others keep what is on disk now, which may have been saved by another run meanwhile.
+     * @return True on success.
+     */
+    bool save() const;
+
+private:
+    /**
+     * @brief Timing history of a single algorithm.
+     */
+    struct AlgorithmHistory {
+        double ns_per_unit = 0; ///< Moving average of the measured cost
+        size_t samples = 0;     ///< Number of measured games
+    };
+
+    std::string history_path;                        ///< Path of the history file
+    std::map<std::string, AlgorithmHistory> history; ///< Algorithm name -> timing history
+    std::set<std::string> measured;                  ///< Algorithms that got a sample in this run
+    double default_ns_per_unit = 1;                  ///< Cost used for algorithms without history
+
+    /**
+     * @brief Reads a history file; unreadable lines are skipped.
+     * @param path Path of the history file.
+     * @param history Output parameter, the algorithms of the file are added.
+     */
+    static void load(const std::string& path, std::map<std::string, AlgorithmHistory>& history);
+
+    /**
+     * @brief Returns the cost per unit of an algorithm, or the default if it has no history.
+     * @param algorithm Name of the algorithm.
+     */
+    double nsPerUnit(const std::string& algorithm) const;
+
+    /**
+     * @brief Recomputes the default cost as the average of all known algorithms.
+     */
+    void updateDefault();
+};
+
+} // namespace Simulator_206480972_206899163
@@ -2,6 +2,7 @@
 #pragma once
 #include <vector>
 #include <memory>
+#include <string>
 #include <functional>
 #include "../common/AbstractGameManager.h"
 
@@ -12,6 +13,14 @@ public:
 
     static GameManagerRegistrar& getGameManagerRegistrar();
 
+    /**
+     * @brief Records the name of the shared object whose game manager is about to register.
+     * @param name Name of the shared object.
+     */
+    void createGameManagerEntry(const std::string& name) {
+        names.push_back(name);
+    }
+
     void addGameManagerFactory(std::function<std::unique_ptr<AbstractGameManager>(bool)>&& factory) {
         managers.emplace_back(factory);
     }
@@ -25,13 +34,25 @@ public:
     auto getAt(int index) const {
         return managers[index];
     }
+    /**
+     * @brief Remove the last registration entry (its name and, if registered, its factory).
+     */
+    void removeLast() {
+        if (managers.size() == names.size() && !managers.empty()) {
+            managers.pop_back();
+        }
+        if (!names.empty()) {
+            names.pop_back();
+        }
+    }
     std::size_t count() const { return managers.size(); }
-    void clear() { managers.clear(); }
+    void clear() { managers.clear(); names.clear(); }
 
     static GameManagerRegistrar registrar;
 
 private:
     std::vector<std::function<std::unique_ptr<AbstractGameManager>(bool)>> managers;
+    std::vector<std::string> names; ///< Shared object name of each game manager
 };
 
 
@@ -0,0 +1,175 @@
+#include "GameResultCache.h"
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iterator>
+#include <sstream>
+#include <unistd.h>
+
+namespace Simulator_206480972_206899163 {
+
+GameResultCache::GameResultCache(const std::string& cache_path) : cache_path(cache_path) {
+    // A missing or partially broken cache file simply leaves games uncached
+    load(cache_path, entries, files);
+}
+
+void GameResultCache::load(const std::string& path, std::map<std::string, CachedResult>& entries,
+                           std::map<std::string, std::string>& files) {
+    // This function reads the tracked files and the games, later lines replace earlier ones
+    std::ifstream in(path);
+    std::string line;
+    while (in && std::getline(in, line)) {
+        std::istringstream fields(line);
+        if (line.rfind("file ", 0) == 0) {
+            std::string kind, hash, file_path;
+            if (fields >> kind >> hash && std::getline(fields >> std::ws, file_path) && !file_path.empty()) {
+                files[file_path] = hash;
+            }
+            continue;
+        }
+        ResultCacheKey key;
+        CachedResult result;
+        int reason;
+        if (fields >> key.game_manager >> key.player1 >> key.player2 >> key.map >> result.winner >> reason >> result.rounds &&
+            result.winner >= 0 && result.winner <= 2 && reason >= GameResult::ALL_TANKS_DEAD && reason <= GameResult::ZERO_SHELLS) {
+            result.reason = static_cast<GameResult::Reason>(reason);
+            entries[keyText(key)] = result;
+        }
+    }
+}
+
+std::string GameResultCache::hashFile(const std::string& path) {
+    // This function hashes the bytes of the file in blocks, the size is folded in at the end
+    std::ifstream in(path, std::ios::binary);
+    if (!in) {
+        return "";
+    }
+    std::uint64_t hash = 14695981039346656037ull;
+    std::uint64_t size = 0;
+    char buffer[1 << 16];
+    while (in.read(buffer, sizeof(buffer)) || in.gcount() > 0) {
+        const std::streamsize count = in.gcount();
+        for (std::streamsize i = 0; i < count; ++i) {
+            hash = (hash ^ static_cast<unsigned char>(buffer[i])) * 1099511628211ull;
+        }
+        size += static_cast<std::uint64_t>(count);
+    }
+    if (in.bad()) {
+        return "";
+    }
+    hash = (hash ^ size) * 1099511628211ull;
+    std::ostringstream text;
+    text << std::hex << std::setw(16) << std::setfill('0') << hash;
+    return text.str();
+}
+
+bool GameResultCache::lookup(const ResultCacheKey& key, CachedResult& result) const {
+    // This function returns the cached result of the game, if any
+    auto it = entries.find(keyText(key));
+    if (it == entries.end()) {
+        return false;
+    }
+    result = it->second;
+    return true;
+}
+
+void GameResultCache::store(const ResultCacheKey& key, const CachedResult& result) {
+    // This function stores the result; a key with a missing hash cannot be trusted and is skipped
+    if (key.game_manager.empty() || key.player1.empty() || key.player2.empty() || key.map.empty()) {
+        return;
+    }
+    entries[keyText(key)] = result;
+}
+
+void GameResultCache::trackFile(const std::string& path, const std::string& hash) {
+    // This function retires the old hash of a file whose content changed since it was last tracked
+    if (hash.empty()) {
+        return;
+    }
+    std::error_code error;
+    std::filesystem::path canonical = std::filesystem::weakly_canonical(path, error);
+    const std::string file_path = error ? path : canonical.string();
+    auto it = files.find(file_path);
+    if (it != files.end() && it->second != hash) {
+        retired.insert(it->second);
+    }
+    files[file_path] = hash;
+    retired.erase(hash);
+    dropRetired(entries, files, retired);
+}
+
+void GameResultCache::dropRetired(std::map<std::string, CachedResult>& entries, const std::map<std::string, std::string>& files,
+                                  const std::set<std::string>& retired) {
+    // This function drops the entries of files that changed since they were cached
+    std::set<std::string> stale = retired;
+    for (const auto& [file_path, hash] : files) {
+        stale.erase(hash);
+    }
+    if (stale.empty()) {
+        return;
+    }
+    for (auto it = entries.begin(); it != entries.end();) {
+        std::istringstream fields(it->first);
+        std::string hash;
+        bool live = true;
+        while (live && fields >> hash) {
+            live = stale.count(hash) == 0;
+        }
+        it = live ? std::next(it) : entries.erase(it);
+    }
+}
+
+size_t GameResultCache::size() const {
+    // This function returns the number of cached games
+    return entries.size();
+}
+
+bool GameResultCache::save() const {
+    // This function merges with what other runs saved meanwhile (this run's entries and hashes win), then
+    // replaces the cache file through a temporary file of this process
+    std::map<std::string, CachedResult> merged_entries;
+    std::map<std::string, std::string> merged_files;
+    load(cache_path, merged_entries, merged_files);
+    for (const auto& [key, result] : entries) {
+        merged_entries[key] = result;
+    }
+    for (const auto& [file_path, hash] : files) {
+        merged_files[file_path] = hash;
+    }
+    dropRetired(merged_entries, merged_files, retired);
+
+    const std::string temporary = cache_path + ".tmp" + std::to_string(getpid());
+    {
+        std::ofstream out(temporary, std::ios::out | std::ios::trunc);
+        if (!out) {
+            return false;
+        }
+        for (const auto& [file_path, hash] : merged_files) {
+            out << "file " << hash << " " << file_path << "\n";
+        }
+        for (const auto& [key, result] : merged_entries) {
+            out << key << " " << result.winner << " " << static_cast<int>(result.reason) << " " << result.rounds << "\n";
+        }
+        if (!out.flush()) {
+            out.close();
+            std::error_code error;
+            std::filesystem::remove(temporary, error);
+            return false;
+        }
+    }
+    std::error_code error;
+    std::filesystem::rename(temporary, cache_path, error);
+    if (error) {
+        std::filesystem::remove(temporary, error);
+        return false;
+    }
+    return true;
+}
+
+std::string GameResultCache::keyText(const ResultCacheKey& key) {
+    // This function joins the four hashes in a fixed order, so player order is part of the key
+    return key.game_manager + " " + key.player1 + " " + key.player2 + " " + key.map;
+}
+
+} // namespace Simulator_206480972_206899163
@@ -0,0 +1,130 @@
+#pragma once
+#include <cstddef>
+#include <map>
+#include <set>
+#include <string>
+#include "../common/GameResult.h"
+
+/**
+ * @file GameResultCache.h
+ * @brief Declares the content-addressed cache of competition game results.
+ */
+
+namespace Simulator_206480972_206899163 {
+
+/**
+ * @struct ResultCacheKey
+ * @brief Identifies a game by the content of everything that decides it, in player order.
+ */
+struct ResultCacheKey {
+    std::string game_manager; ///< Hash of the game manager .so
+    std::string player1;      ///< Hash of the algorithm .so playing as player 1
+    std::string player2;      ///< Hash of the algorithm .so playing as player 2
+    std::string map;          ///< Hash of the map file
+};
+
+/**
+ * @struct CachedResult
+ * @brief The outcome of a cached game.
+ */
+struct CachedResult {
+    int winner = 0;                                    ///< 0 = tie, 1 or 2 = winning player
+    GameResult::Reason reason = GameResult::MAX_STEPS; ///< Why the game ended
+    size_t rounds = 0;                                 ///< Number of rounds played
+};
+
+/**
+ * @class GameResultCache
+ * @brief Results of earlier competition games, reused when neither the libraries nor the map changed.
+ *
+ * Games are deterministic given the game manager, both algorithms (in player order) and the map, so the
+ * result is keyed by a hash of the content of these four files. The cache also remembers the last hash seen
+ * for every file path; when trackFile() sees a path with new content, the entries of its old hash can never
+ * match again and are dropped. Files that are merely absent from a run keep their entries.
+ * The cache file holds one "file <hash> <path>" line per tracked file and one
+ * "<gm> <player1> <player2> <map> <winner> <reason> <rounds>" line per game. Several runs (e.g. shards)
+ * may share it: save() merges with the file on disk and replaces it atomically.
+ * The cache is used by the main thread only.
+ */
+class GameResultCache {
+public:
+    /**
+     * @brief Constructs the cache and loads the cache file, if it exists.
+     * @param cache_path Path of the cache file.
+     */
+    explicit GameResultCache(const std::string& cache_path);
+
+    /**
+     * @brief Hashes the content of a file (64 bit FNV-1a over the bytes and the size).
+     * @param path Path of the file.
+     * @return The hash as 16 hex digits, or an empty string if the file cannot be read.
+     */
+    static std::string hashFile(const std::string& path);
+
+    /**
+     * @brief Looks up the result of a game.
+     * @param key The game.
+     * @param result Output parameter for the cached result.
+     * @return True if the game is cached.
+     */
+    bool lookup(const ResultCacheKey& key, CachedResult& result) const;
+
+    /**
+     * @brief Stores the result of a game, replacing any earlier one.
+     * @param key The game. Keys with an empty hash (unreadable file) are not stored.
+     * @param result The result of the game.
+     */
+    void store(const ResultCacheKey& key, const CachedResult& result);
+
+    /**
+     * @brief Records the current hash of a file the games depend on. If the path had another hash before, the
+     *        entries of that hash are dropped, unless another tracked file still has it.
+     * @param path Path of the game manager, algorithm or map file.
+     * @param hash Its current hash; an empty hash (unreadable file) is ignored.
+     */
+    void trackFile(const std::string& path, const std::string& hash);
+
+    /**
+     * @brief Returns the number of cached games.
+     */
+    size_t size() const;
+
+    /**
+     * @brief Writes the cache file, merged with the entries other runs saved since it was loaded, through a
+     *        temporary file, so a concurrent reader never sees a half-written file.
+     * @return True on success.
+     */
+    bool save() const;
+
+private:
+    std::string cache_path;                                ///< Path of the cache file
+    std::map<std::string, CachedResult> entries;           ///< "<gm> <player1> <player2> <map>" -> result
+    std::map<std::string, std::string> files;              ///< Path of a tracked file -> its last seen hash
+    std::set<std::string> retired;                         ///< Hashes trackFile() saw replaced in this run
+
+    /**
+     * @brief Reads a cache file; unreadable lines are skipped.
+     * @param path Path of the cache file.
+     * @param entries Output parameter, the entries of the file are added.
+     * @param files Output parameter, the tracked files of the file are added.
+     */
+    static void load(const std::string& path, std::map<std::string, CachedResult>& entries,
+                     std::map<std::string, std::string>& files);
+
+    /**
+     * @brief Drops the entries that mention a retired hash no tracked file has anymore.
+     * @param entries The entries to prune.
+     * @param files The tracked files.
+     * @param retired The retired hashes.
+     */
+    static void dropRetired(std::map<std::string, CachedResult>& entries, const std::map<std::string, std::string>& files,
+                            const std::set<std::string>& retired);
+
+    /**
+     * @brief Returns the text form of a key, as used in the cache file.
+     * @param key The key.
+     */
+    static std::string keyText(const ResultCacheKey& key);
+};
+
+} // namespace Simulator_206480972_206899163
@@ -75,7 +75,7 @@ void GameResultWriter::writeComparativeResults(
     // 1) Pre-render maps and build signatures to group identical outcomes.
     struct Bucket {
         std::vector<std::string> names;     // game manager names in this bucket
-        GameResult representative;          // for message/rounds/map printing
+        const GameResult* representative = nullptr; // for message/rounds/map printing
         std::vector<std::string> finalMap;  // cached final map lines
     };
 
@@ -100,7 +100,7 @@ void GameResultWriter::writeComparativeResults(
 
         auto& bucket = buckets[key];
         if (bucket.names.empty()) {
-            bucket.representative = gr;      // first one becomes representative
+            bucket.representative = &gr;     // first one becomes representative
             bucket.finalMap = mapLines;      // cache map for printing
         }
         bucket.names.push_back(gmName);
@@ -139,10 +139,10 @@ void GameResultWriter::writeComparativeResults(
         out << "\n";
 
         // 6th line: game result message (as in assignment 2)
-        out << resultMessage(g.representative) << "\n";
+        out << resultMessage(*g.representative) << "\n";
 
         // 7th line: round number (just a number)
-        out << g.representative.rounds << "\n";
+        out << g.representative->rounds << "\n";
 
         // 8th line on: full map of the final state
         if (!g.finalMap.empty()) {
@@ -155,24 +155,53 @@ void GameResultWriter::writeComparativeResults(
 
     const std::string content = out.str();
 
-    // 4) Build filename with a monotonically increasing time-based number.
+    // 4) Write the content to comparative_results_<time>.txt, or to screen on failure.
+    writeOutputFile(game_managers_folder, "comparative_results_", content);
+}
+
+/**
+ * Writes the competition results file (or prints to screen if file creation fails).
+ *
+ * @param algorithms_folder folder where the output file should be created
+ * @param game_maps_folder the game maps folder, printed as given
+ * @param game_manager_so path to the game manager .so (we will print only its filename)
+ * @param scores (algorithm name, total score) pairs, already sorted by descending score
+ */
+void GameResultWriter::writeCompetitionResults(
+    const std::string& algorithms_folder,
+    const std::string& game_maps_folder,
+    const std::string& game_manager_so,
+    const std::vector<std::pair<std::string, long long>>& scores
+) {
+    std::ostringstream out;
+    out << "game_maps_folder=" << game_maps_folder << "\n";
+    out << "game_manager=" << justFilename(game_manager_so) << "\n";
+    out << "\n";
+    for (const auto& [name, score] : scores) {
+        out << name << " " << score << "\n";
+    }
+    writeOutputFile(algorithms_folder, "competition_", out.str());
+}
+
+void GameResultWriter::writeOutputFile(const std::string& folder, const std::string& prefix, const std::string& content) {
+    // Build filename with a monotonically increasing time-based number.
     // Use nanoseconds since epoch to reduce collision risk.
     const auto now = std::chrono::time_point_cast<std::chrono::nanoseconds>(
         std::chrono::system_clock::now()
     );
     const auto tnum = now.time_since_epoch().count();
 
-    std::string filename = "comparative_results_" + std::to_string(tnum) + ".txt";
+    std::string filename = prefix + std::to_string(tnum) + ".txt";
     std::string fullpath;
     try {
-        std::filesystem::path dir(game_managers_folder);
+        std::filesystem::path dir(folder);
         fullpath = (dir / filename).string();
     } catch (...) {
         // If folder path is weird, just try to write in place
         fullpath = filename;
     }
 
-    // 5) Try writing to file; on failure, print error and dump content to screen.
+    // Try writing to file; on failure, print error and dump content to screen.
     std::ofstream ofs(fullpath, std::ios::out | std::ios::trunc);
     if (!ofs) {
         std::cerr << "Error: could not create output file at '" << fullpath
@@ -182,4 +211,4 @@ void GameResultWriter::writeComparativeResults(
     }
     ofs << content;
     ofs.close();
-}
\ No newline at end of file
+}
@@ -30,8 +30,31 @@ public:
         const std::function<std::vector<std::string>(const SatelliteView&)>& renderGameState
     );
 
+    /**
+     * Writes the competition results file (or prints to screen if file creation fails).
+     *
+     * @param algorithms_folder folder where the output file should be created
+     * @param game_maps_folder the game maps folder, printed as given
+     * @param game_manager_so path to the game manager .so (we will print only its filename)
+     * @param scores (algorithm name, total score) pairs, already sorted by descending score
+     */
+    void writeCompetitionResults(
+        const std::string& algorithms_folder,
+        const std::string& game_maps_folder,
+        const std::string& game_manager_so,
+        const std::vector<std::pair<std::string, long long>>& scores
+    );
+
 private:
 
+    /**
+     * Writes content to <folder>/<prefix><time>.txt, or prints it to screen if the file cannot be created.
+     *
+     * @param folder folder where the output file should be created
+     * @param prefix file name prefix, the time-based number and ".txt" are appended
+     * @param content full file content
+     */
+    void writeOutputFile(const std::string& folder, const std::string& prefix, const std::string& content);
 
     std::string reasonToString(GameResult::Reason r);
     std::string resultMessage(const GameResult& gr);
@@ -0,0 +1,207 @@
+#include "GameWatchdog.h"
+#include "../UserCommon/StateHashable.h"
+#include <future>
+#include <thread>
+#include <utility>
+
+namespace Simulator_206480972_206899163 {
+
+namespace {
+
+/**
+ * @brief TankAlgorithm decorator timing every call into the wrapped algorithm.
+ */
+class GuardedTankAlgorithm : public TankAlgorithm {
+protected:
+    std::unique_ptr<TankAlgorithm> algorithm;            ///< The wrapped algorithm
+    std::shared_ptr<GameWatchdog::Monitor> monitor;      ///< Shared watchdog state
+    int player_index;                                    ///< Player owning the tank
+public:
+    GuardedTankAlgorithm(std::unique_ptr<TankAlgorithm> algorithm, std::shared_ptr<GameWatchdog::Monitor> monitor, int player_index)
+        : algorithm(std::move(algorithm)), monitor(std::move(monitor)), player_index(player_index) {}
+
+    ActionRequest getAction() override {
+        // Once a budget was breached the game is decided, stop calling into the players
+        if (monitor->offender.load() != 0) {
+            return ActionRequest::DoNothing;
+        }
+        ActionRequest action = ActionRequest::DoNothing;
+        monitor->timed(player_index, [this, &action]() { action = algorithm->getAction(); });
+        return action;
+    }
+
+    void updateBattleInfo(BattleInfo& info) override {
+        if (monitor->offender.load() != 0) {
+            return;
+        }
+        monitor->timed(player_index, [this, &info]() { algorithm->updateBattleInfo(info); });
+    }
+};
+
+/**
+ * @brief Player decorator timing every battle info update of the wrapped player.
+ */
+class GuardedPlayer : public Player {
+protected:
+    std::unique_ptr<Player> player;                      ///< The wrapped player
+    std::shared_ptr<GameWatchdog::Monitor> monitor;      ///< Shared watchdog state
+    int player_index;                                    ///< Index of the player
+public:
+    GuardedPlayer(std::unique_ptr<Player> player, std::shared_ptr<GameWatchdog::Monitor> monitor, int player_index)
+        : player(std::move(player)), monitor(std::move(monitor)), player_index(player_index) {}
+
+    void updateTankWithBattleInfo(TankAlgorithm& tank, SatelliteView& satellite_view) override {
+        if (monitor->offender.load() != 0) {
+            return;
+        }
+        monitor->timed(player_index, [this, &tank, &satellite_view]() { player->updateTankWithBattleInfo(tank, satellite_view); });
+    }
+};
+
+/**
+ * @brief Hashes a wrapped object, timed like any other call into the player's code.
+ * @param wrapped The wrapped object's state hash extension.
+ * @param monitor The shared watchdog state.
+ * @param player_index The player owning the object.
+ * @return The wrapped hash, or a fixed one once a budget was breached, since from then on the wrapper answers on its own.
+ */
+std::uint64_t guardedStateHash(const StateHashable& wrapped, GameWatchdog::Monitor& monitor, int player_index) {
+    int offender = monitor.offender.load();
+    if (offender != 0) {
+        return combineStateHash(0, static_cast<std::uint64_t>(offender));
+    }
+    std::uint64_t hash = 0;
+    monitor.timed(player_index, [&wrapped, &hash]() { hash = wrapped.stateHash(); });
+    return hash;
+}
+
+/**
+ * @brief GuardedTankAlgorithm of an algorithm implementing StateHashable, so the game manager can still fast forward.
+ */
+class HashableGuardedTankAlgorithm : public GuardedTankAlgorithm, public StateHashable {
+public:
+    using GuardedTankAlgorithm::GuardedTankAlgorithm;
+
+    std::uint64_t stateHash() const override {
+        return guardedStateHash(dynamic_cast<const StateHashable&>(*algorithm), *monitor, player_index);
+    }
+};
+
+/**
+ * @brief GuardedPlayer of a player implementing StateHashable, so the game manager can still fast forward.
+ */
+class HashableGuardedPlayer : public GuardedPlayer, public StateHashable {
+public:
+    using GuardedPlayer::GuardedPlayer;
+
+    std::uint64_t stateHash() const override {
+        return guardedStateHash(dynamic_cast<const StateHashable&>(*player), *monitor, player_index);
+    }
+};
+
+} // namespace
+
+void GameWatchdog::Monitor::timed(int player_index, const std::function<void()>& call) {
+    // This function runs the call while marking the player as active, and flags it if it was too slow
+    active_player.store(player_index);
+    auto start = std::chrono::steady_clock::now();
+    call();
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    active_player.store(0);
+    if (action_budget.count() > 0 && elapsed > action_budget) {
+        int none = 0;
+        offender.compare_exchange_strong(none, player_index);
+    }
+}
+
+GameWatchdog::GameWatchdog(const WatchdogLimits& limits, std::shared_ptr<Monitor> shared_monitor)
+    : limits(limits), wraps_players(limits.enabled() || shared_monitor),
+      monitor(shared_monitor ? std::move(shared_monitor) : std::make_shared<Monitor>()) {
+    monitor->action_budget = limits.action_budget;
+    monitor->active_player.store(0);
+    monitor->offender.store(0);
+}
+
+TankAlgorithmFactory GameWatchdog::guard(TankAlgorithmFactory factory) const {
+    // This function wraps the factory, the wrapper keeps its own reference to the shared state
+    return [factory = std::move(factory), monitor = monitor](int player_index, int tank_index) -> std::unique_ptr<TankAlgorithm> {
+        std::unique_ptr<TankAlgorithm> algorithm = factory(player_index, tank_index);
+        if (dynamic_cast<const StateHashable*>(algorithm.get()) != nullptr) {
+            return std::make_unique<HashableGuardedTankAlgorithm>(std::move(algorithm), monitor, player_index);
+        }
+        return std::make_unique<GuardedTankAlgorithm>(std::move(algorithm), monitor, player_index);
+    };
+}
+
+std::unique_ptr<Player> GameWatchdog::guard(std::unique_ptr<Player> player, int player_index) const {
+    // This function wraps the player, keeping its StateHashable extension visible
+    if (dynamic_cast<const StateHashable*>(player.get()) != nullptr) {
+        return std::make_unique<HashableGuardedPlayer>(std::move(player), monitor, player_index);
+    }
+    return std::make_unique<GuardedPlayer>(std::move(player), monitor, player_index);
+}
+
+GameResult GameWatchdog::run(std::function<GameResult()> game) {
+    // This function runs the game, inline when there is no wall-clock budget, otherwise on its own thread
+    GameResult result;
+    if (limits.game_budget.count() <= 0) {
+        result = game();
+    } else {
+        auto promise = std::make_shared<std::promise<GameResult>>();
+        std::future<GameResult> future = promise->get_future();
+        std::thread([game = std::move(game), promise]() mutable {
+            // the game is destroyed before the result is published: once the worker sees the result
+            // it releases the libraries, and destroying the game may still run library code
+            try {
+                GameResult game_result = game();
+                game = nullptr;
+                promise->set_value(std::move(game_result));
+            } catch (...) {
+                game = nullptr;
+                promise->set_exception(std::current_exception());
+            }
+        }).detach();
+        if (future.wait_for(limits.game_budget) != std::future_status::ready) {
+            // the game thread cannot be stopped; it is left behind and owns everything it still uses
+            was_abandoned = true;
+            int offender = monitor->active_player.load();
+            int none = 0;
+            monitor->offender.compare_exchange_strong(none, offender); // also makes the abandoned game wind down
+            was_forfeited = true;
+            return forfeit(monitor->offender.load(), 0);
+        }
+        result = future.get();
+    }
+    int offender = monitor->offender.load();
+    if (offender != 0) {
+        was_forfeited = true;
+        return forfeit(offender, result.rounds);
+    }
+    return result;
+}
+
+bool GameWatchdog::enabled() const {
+    // This function returns whether the players are wrapped
+    return wraps_players;
+}
+
+bool GameWatchdog::abandoned() const {
+    // This function returns whether the game was abandoned
+    return was_abandoned;
+}
+
+bool GameWatchdog::forfeited() const {
+    // This function returns whether the result was decided by a budget breach
+    return was_forfeited;
+}
+
+GameResult GameWatchdog::forfeit(int offender, size_t rounds) const {
+    // This function scores the offender as losing, or the game as a tie when configured or unknown
+    GameResult result;
+    result.winner = (offender == 0 || limits.timeout_is_tie) ? 0 : 3 - offender;
+    result.reason = GameResult::MAX_STEPS;
+    result.rounds = rounds;
+    return result;
+}
+
+} // namespace Simulator_206480972_206899163
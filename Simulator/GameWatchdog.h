@@ -0,0 +1,128 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <memory>
+#include "../common/GameResult.h"
+#include "../common/Player.h"
+#include "../common/TankAlgorithm.h"
+
+/**
+ * @file GameWatchdog.h
+ * @brief Declares the per-game time budget enforcement of the simulator.
+ */
+
+namespace Simulator_206480972_206899163 {
+
+/**
+ * @struct WatchdogLimits
+ * @brief Time budgets of a single game. A zero budget means "unlimited".
+ */
+struct WatchdogLimits {
+    std::chrono::milliseconds game_budget{0};   ///< Wall-clock budget of the whole game
+    std::chrono::milliseconds action_budget{0}; ///< Budget of a single getAction / battle info update
+    bool timeout_is_tie = false;                ///< Score a breach as a tie instead of a loss of the offender
+
+    /**
+     * @brief Returns whether any budget is set.
+     */
+    bool enabled() const { return game_budget.count() > 0 || action_budget.count() > 0; }
+};
+
+/**
+ * @class GameWatchdog
+ * @brief Runs a single game under a wall-clock budget and a per-call budget for the player's code.
+ *
+ * Tank algorithms and players are wrapped so the watchdog knows which player is currently running and how
+ * long each call took. A call over the action budget marks its player as the offender; from then on all
+ * wrapped algorithms answer DoNothing without calling into the player's code, so the game finishes quickly,
+ * and its result is replaced by a loss of the offender (or a tie). If the whole game exceeds its budget, the
+ * worker stops waiting for it: the game thread is abandoned and keeps only what it owns, and the player that
+ * was running at that moment (if any) is blamed. Forfeit results use GameResult::MAX_STEPS as the reason.
+ *
+ * Note that wrapping hides the concrete TankAlgorithm type from the Player, so players that downcast the
+ * algorithm they receive only work when no budget is set. The optional StateHashable extension is kept: a
+ * wrapped object implements it exactly when the original does.
+ */
+class GameWatchdog {
+public:
+    struct Monitor;
+
+    /**
+     * @brief Constructs a watchdog for a single game.
+     * @param limits The budgets of the game.
+     * @param shared_monitor Externally owned monitor (e.g. in shared memory, so another process can see which
+     *        player was running); it is reset for this game and the players are always wrapped. Optional.
+     */
+    explicit GameWatchdog(const WatchdogLimits& limits, std::shared_ptr<Monitor> shared_monitor = nullptr);
+
+    /**
+     * @brief Wraps a tank algorithm factory so that every created algorithm is timed.
+     * @param factory The original factory.
+     * @return The guarding factory.
+     */
+    TankAlgorithmFactory guard(TankAlgorithmFactory factory) const;
+
+    /**
+     * @brief Wraps a player so that its battle info updates are timed.
+     * @param player The original player.
+     * @param player_index The index of the player (1 or 2).
+     * @return The guarding player.
+     */
+    std::unique_ptr<Player> guard(std::unique_ptr<Player> player, int player_index) const;
+
+    /**
+     * @brief Runs the game under the budgets. The game must own everything it uses, since an abandoned
+     *        game keeps running on its own thread after this function returned.
+     * @param game Function running the game and returning its result.
+     * @return The result of the game, or a forfeit result if a budget was exceeded.
+     */
+    GameResult run(std::function<GameResult()> game);
+
+    /**
+     * @brief Returns whether the players need to be wrapped: a budget is set or the monitor is shared.
+     */
+    bool enabled() const;
+
+    /**
+     * @brief Returns whether the game was abandoned after exceeding its wall-clock budget.
+     */
+    bool abandoned() const;
+
+    /**
+     * @brief Returns whether the result of run() was a forfeit instead of the result of the game.
+     */
+    bool forfeited() const;
+
+    /**
+     * @brief State shared between the watchdog and the wrapped algorithms and players.
+     */
+    struct Monitor {
+        std::chrono::milliseconds action_budget{0}; ///< Budget of a single call
+        std::atomic<int> active_player{0};          ///< Player whose code is running now (0 = none)
+        std::atomic<int> offender{0};               ///< First player that exceeded a budget (0 = none)
+
+        /**
+         * @brief Runs a call of the player's code, timing it and recording a budget breach.
+         * @param player_index The index of the player making the call.
+         * @param call The call to run.
+         */
+        void timed(int player_index, const std::function<void()>& call);
+    };
+
+private:
+    WatchdogLimits limits;            ///< The budgets of the game
+    bool wraps_players;               ///< True if the players and tank algorithms are wrapped
+    std::shared_ptr<Monitor> monitor; ///< Shared with the wrappers, which may outlive the watchdog
+    bool was_abandoned = false;       ///< True if run() gave up on the game
+    bool was_forfeited = false;       ///< True if run() returned a forfeit
+
+    /**
+     * @brief Builds the result of a game decided by a budget breach.
+     * @param offender Player that exceeded a budget (0 if unknown).
+     * @param rounds Number of rounds to report.
+     */
+    GameResult forfeit(int offender, size_t rounds) const;
+};
+
+} // namespace Simulator_206480972_206899163
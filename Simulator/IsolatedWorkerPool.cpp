@@ -0,0 +1,266 @@
+#include "IsolatedWorkerPool.h"
+#include <algorithm>
+#include <cerrno>
+#include <csignal>
+#include <deque>
+#include <iostream>
+#include <new>
+#include <stdexcept>
+#include <ctime>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+namespace Simulator_206480972_206899163 {
+
+IsolatedWorkerPool::IsolatedWorkerPool(std::size_t requested_workers, GameRunner runner)
+    : num_workers(std::max<std::size_t>(requested_workers, 1)), runner(std::move(runner)), workers(num_workers) {
+    // A worker has at most one unreported game, so the ring never holds more entries than there are workers
+    const std::size_t capacity = num_workers;
+    shared_size = sizeof(SharedHeader) + num_workers * sizeof(Monitor) + capacity * sizeof(RingEntry);
+    shared = mmap(nullptr, shared_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+    if (shared == MAP_FAILED) {
+        shared = nullptr;
+        throw std::runtime_error("failed to allocate shared memory for the worker processes");
+    }
+    SharedHeader& shared_header = header();
+    pthread_mutexattr_t attributes;
+    pthread_mutexattr_init(&attributes);
+    pthread_mutexattr_setpshared(&attributes, PTHREAD_PROCESS_SHARED);
+    pthread_mutexattr_setrobust(&attributes, PTHREAD_MUTEX_ROBUST);
+    pthread_mutex_init(&shared_header.mutex, &attributes);
+    pthread_mutexattr_destroy(&attributes);
+    sem_init(&shared_header.results_ready, 1, 0);
+    shared_header.head = 0;
+    shared_header.tail = 0;
+    shared_header.capacity = capacity;
+    for (std::size_t i = 0; i < num_workers; ++i) {
+        new (&monitors()[i]) Monitor();
+    }
+    // a dead worker must not kill the simulator when a game id is written to its pipe; the previous disposition
+    // is restored by the destructor
+    struct sigaction ignore {};
+    ignore.sa_handler = SIG_IGN;
+    sigemptyset(&ignore.sa_mask);
+    sigaction(SIGPIPE, &ignore, &previous_sigpipe);
+}
+
+IsolatedWorkerPool::~IsolatedWorkerPool() {
+    // Stop the workers before the shared memory they use goes away
+    for (std::size_t i = 0; i < workers.size(); ++i) {
+        stop(i);
+    }
+    if (shared) {
+        for (std::size_t i = 0; i < num_workers; ++i) {
+            monitors()[i].~Monitor();
+        }
+        sem_destroy(&header().results_ready);
+        pthread_mutex_destroy(&header().mutex);
+        munmap(shared, shared_size);
+    }
+    sigaction(SIGPIPE, &previous_sigpipe, nullptr);
+}
+
+IsolatedWorkerPool::SharedHeader& IsolatedWorkerPool::header() const {
+    return *static_cast<SharedHeader*>(shared);
+}
+
+IsolatedWorkerPool::Monitor* IsolatedWorkerPool::monitors() const {
+    return reinterpret_cast<Monitor*>(static_cast<char*>(shared) + sizeof(SharedHeader));
+}
+
+IsolatedWorkerPool::RingEntry* IsolatedWorkerPool::ring() const {
+    return reinterpret_cast<RingEntry*>(static_cast<char*>(shared) + sizeof(SharedHeader) + num_workers * sizeof(Monitor));
+}
+
+void IsolatedWorkerPool::run(const std::vector<std::size_t>& game_ids, const ResultHandler& on_result, const CrashHandler& on_crash) {
+    // This function hands out the games, collects the records and replaces workers that died
+    std::deque<std::size_t> pending(game_ids.begin(), game_ids.end());
+    std::size_t outstanding = game_ids.size();
+    auto hand_out = [this, &pending](std::size_t worker) {
+        while (!pending.empty()) {
+            if (workers[worker].pid < 0 && !spawn(worker)) {
+                throw std::runtime_error("failed to fork a worker process");
+            }
+            if (assign(worker, pending.front())) {
+                pending.pop_front();
+                return;
+            }
+            stop(worker); // the worker died before it got the game, fork a new one and try again
+        }
+        stop(worker);
+    };
+    auto take_records = [this, &outstanding, &on_result, &hand_out]() {
+        for (const RingEntry& entry : drain()) {
+            Worker& worker = workers[entry.worker];
+            if (!worker.busy || worker.game_id != entry.game_id) {
+                continue;
+            }
+            worker.busy = false;
+            --outstanding;
+            if (!entry.failed) {
+                on_result(entry.game_id, entry.record);
+            }
+            if (!entry.failed && entry.record.abandoned) {
+                stop(entry.worker); // the worker exits after reporting an abandoned game, a new one is forked
+            }
+            hand_out(entry.worker);
+        }
+    };
+    for (std::size_t i = 0; i < std::min(num_workers, game_ids.size()); ++i) {
+        hand_out(i);
+    }
+
+    while (outstanding > 0) {
+        timespec deadline;
+        clock_gettime(CLOCK_REALTIME, &deadline);
+        deadline.tv_nsec += 100 * 1000 * 1000; // wake up regularly to look for dead workers
+        if (deadline.tv_nsec >= 1000 * 1000 * 1000) {
+            deadline.tv_sec += 1;
+            deadline.tv_nsec -= 1000 * 1000 * 1000;
+        }
+        while (sem_timedwait(&header().results_ready, &deadline) == -1 && errno == EINTR) {
+        }
+        take_records();
+        pid_t pid;
+        while ((pid = waitpid(-1, nullptr, WNOHANG)) > 0) {
+            auto it = std::find_if(workers.begin(), workers.end(), [pid](const Worker& w) { return w.pid == pid; });
+            if (it == workers.end()) {
+                continue;
+            }
+            const std::size_t index = static_cast<std::size_t>(it - workers.begin());
+            close(it->task_fd);
+            it->task_fd = -1;
+            it->pid = -1;
+            take_records(); // the worker may have pushed its record right before it died
+            if (it->busy && it->pid < 0) { // not already handed a new game by a new worker in this slot
+                it->busy = false;
+                --outstanding;
+                std::cerr << "Worker process " << pid << " died while running game " << it->game_id << std::endl;
+                on_crash(it->game_id, monitors()[index].active_player.load());
+                hand_out(index);
+            }
+        }
+    }
+}
+
+bool IsolatedWorkerPool::spawn(std::size_t worker) {
+    // This function forks a worker; the child keeps only the read end of its own pipe
+    int fds[2];
+    if (pipe(fds) != 0) {
+        return false;
+    }
+    std::cout.flush(); // buffered output must not be written twice
+    std::cerr.flush();
+    pid_t pid = fork();
+    if (pid < 0) {
+        close(fds[0]);
+        close(fds[1]);
+        return false;
+    }
+    if (pid == 0) {
+        close(fds[1]);
+        // other workers only see the end of their pipe once no process holds its write end
+        for (const Worker& other : workers) {
+            if (other.task_fd >= 0) {
+                close(other.task_fd);
+            }
+        }
+        workerMain(worker, fds[0]);
+    }
+    close(fds[0]);
+    workers[worker].pid = pid;
+    workers[worker].task_fd = fds[1];
+    workers[worker].busy = false;
+    return true;
+}
+
+void IsolatedWorkerPool::workerMain(std::size_t worker, int task_fd) {
+    // This function runs in the child: it runs games until the parent closes the pipe or a game is abandoned,
+    // then exits without running the parent's destructors (which would unload libraries and write output files)
+    std::shared_ptr<Monitor> monitor(&monitors()[worker], [](Monitor*) {}); // owned by the shared memory
+    std::size_t game_id;
+    while (read(task_fd, &game_id, sizeof(game_id)) == static_cast<ssize_t>(sizeof(game_id))) {
+        RingEntry entry{worker, game_id, false, GameRecord{}};
+        try {
+            entry.record = runner(game_id, monitor);
+        } catch (const std::exception& e) {
+            std::cerr << "Game task failed: " << e.what() << std::endl;
+            entry.failed = true;
+        } catch (...) {
+            std::cerr << "Game task failed with an unknown error" << std::endl;
+            entry.failed = true;
+        }
+        push(entry);
+        if (!entry.failed && entry.record.abandoned) {
+            break; // exiting is the only way to stop the abandoned game thread
+        }
+    }
+    std::cout.flush();
+    std::cerr.flush();
+    _exit(0);
+}
+
+bool IsolatedWorkerPool::assign(std::size_t worker, std::size_t game_id) {
+    // This function writes the game id into the worker's pipe
+    Worker& state = workers[worker];
+    if (write(state.task_fd, &game_id, sizeof(game_id)) != static_cast<ssize_t>(sizeof(game_id))) {
+        return false;
+    }
+    state.busy = true;
+    state.game_id = game_id;
+    return true;
+}
+
+void IsolatedWorkerPool::stop(std::size_t worker) {
+    // This function closes the pipe and reaps the worker
+    Worker& state = workers[worker];
+    if (state.task_fd >= 0) {
+        close(state.task_fd);
+        state.task_fd = -1;
+    }
+    if (state.pid > 0) {
+        waitpid(state.pid, nullptr, 0);
+        state.pid = -1;
+    }
+    state.busy = false;
+}
+
+void IsolatedWorkerPool::push(const RingEntry& entry) {
+    // This function appends the entry; tail is advanced last, so an entry of a worker that died mid-write is dropped
+    SharedHeader& shared_header = header();
+    while (true) {
+        lock();
+        if (shared_header.tail - shared_header.head < shared_header.capacity) {
+            ring()[shared_header.tail % shared_header.capacity] = entry;
+            ++shared_header.tail;
+            pthread_mutex_unlock(&shared_header.mutex);
+            sem_post(&shared_header.results_ready);
+            return;
+        }
+        pthread_mutex_unlock(&shared_header.mutex);
+        usleep(1000);
+    }
+}
+
+std::vector<IsolatedWorkerPool::RingEntry> IsolatedWorkerPool::drain() {
+    // This function copies out every entry pushed since the last drain
+    SharedHeader& shared_header = header();
+    std::vector<RingEntry> entries;
+    lock();
+    while (shared_header.head < shared_header.tail) {
+        entries.push_back(ring()[shared_header.head % shared_header.capacity]);
+        ++shared_header.head;
+    }
+    pthread_mutex_unlock(&shared_header.mutex);
+    return entries;
+}
+
+void IsolatedWorkerPool::lock() {
+    // This function locks the mutex; if a worker died holding it, its (uncommitted) changes are simply ignored
+    if (pthread_mutex_lock(&header().mutex) == EOWNERDEAD) {
+        pthread_mutex_consistent(&header().mutex);
+    }
+}
+
+} // namespace Simulator_206480972_206899163
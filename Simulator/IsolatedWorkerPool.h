@@ -0,0 +1,162 @@
+#pragma once
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <vector>
+#include <pthread.h>
+#include <semaphore.h>
+#include <signal.h>
+#include <sys/types.h>
+#include "CompetitionScoreTable.h"
+#include "GameWatchdog.h"
+
+/**
+ * @file IsolatedWorkerPool.h
+ * @brief Declares a pool of forked worker processes that run games in isolation from the simulator.
+ */
+
+namespace Simulator_206480972_206899163 {
+
+/**
+ * @class IsolatedWorkerPool
+ * @brief Runs games in pre-forked worker processes, so that a crashing algorithm only takes down its worker.
+ *
+ * The workers are forked from the simulator after every library is loaded and every map is parsed, so they
+ * inherit all of that copy-on-write and stay warm for all the games they run. The parent hands game ids to
+ * the workers through one pipe per worker; a worker runs the game and pushes its record into a ring buffer
+ * in shared memory, guarded by a robust process-shared mutex, and posts a semaphore the parent waits on.
+ * Every worker also has a watchdog monitor in shared memory, so after a crash the parent still knows which
+ * player's code was running. A worker that dies is reaped, its game is reported as crashed and a new worker
+ * is forked in its place while games remain. A worker whose game was abandoned (GameRecord::abandoned) exits right
+ * after reporting it, since the abandoned game would otherwise keep running next to its later games; it is
+ * replaced the same way.
+ *
+ * The pool must be used from a single-threaded process, since only the forking thread exists in the child.
+ */
+class IsolatedWorkerPool {
+public:
+    using Monitor = GameWatchdog::Monitor;
+    /// Runs a game inside a worker and returns its record, using the given monitor for its watchdog.
+    using GameRunner = std::function<GameRecord(std::size_t game_id, const std::shared_ptr<Monitor>& monitor)>;
+    /// Called in the parent for every game a worker finished.
+    using ResultHandler = std::function<void(std::size_t game_id, const GameRecord& record)>;
+    /// Called in the parent for every game whose worker died, with the player that was running (0 if unknown).
+    using CrashHandler = std::function<void(std::size_t game_id, int offender)>;
+
+    /**
+     * @brief Constructs the pool and allocates its shared memory. No worker is forked yet.
+     * @param requested_workers Number of worker processes (num_threads argument).
+     * @param runner Function running a single game inside a worker.
+     */
+    IsolatedWorkerPool(std::size_t requested_workers, GameRunner runner);
+
+    // Rule of 5
+    IsolatedWorkerPool(const IsolatedWorkerPool&) = delete;
+    IsolatedWorkerPool& operator=(const IsolatedWorkerPool&) = delete;
+    IsolatedWorkerPool(IsolatedWorkerPool&&) = delete;
+    IsolatedWorkerPool& operator=(IsolatedWorkerPool&&) = delete;
+
+    /**
+     * @brief Stops any remaining worker, frees the shared memory and restores the SIGPIPE disposition.
+     */
+    ~IsolatedWorkerPool();
+
+    /**
+     * @brief Runs the games on the workers, in the given order, and returns once every game was reported.
+     * @param game_ids Ids of the games to run, in scheduling order.
+     * @param on_result Handler for finished games.
+     * @param on_crash Handler for games whose worker died.
+     */
+    void run(const std::vector<std::size_t>& game_ids, const ResultHandler& on_result, const CrashHandler& on_crash);
+
+private:
+    /**
+     * @brief A record pushed by a worker.
+     */
+    struct RingEntry {
+        std::size_t worker;  ///< Index of the worker that ran the game
+        std::size_t game_id; ///< Id of the game
+        bool failed;         ///< True if the game threw instead of finishing
+        GameRecord record;   ///< Outcome of the game
+    };
+
+    /**
+     * @brief Header of the shared memory block, followed by the monitors and the ring entries.
+     */
+    struct SharedHeader {
+        pthread_mutex_t mutex; ///< Robust process-shared mutex guarding head and tail
+        sem_t results_ready;   ///< Posted once per pushed entry
+        std::size_t head;      ///< Next entry the parent reads
+        std::size_t tail;      ///< Next entry a worker writes
+        std::size_t capacity;  ///< Number of ring entries
+    };
+
+    /**
+     * @brief Parent side state of a worker process.
+     */
+    struct Worker {
+        pid_t pid = -1;                ///< Process id, -1 if not running
+        int task_fd = -1;              ///< Write end of the worker's game id pipe
+        bool busy = false;             ///< True while a game is assigned
+        std::size_t game_id = 0;       ///< The assigned game
+    };
+
+    std::size_t num_workers;       ///< Number of worker processes
+    GameRunner runner;             ///< Runs a game inside a worker
+    std::vector<Worker> workers;   ///< Parent side state of the workers
+    void* shared = nullptr;        ///< The shared memory block
+    std::size_t shared_size = 0;   ///< Size of the shared memory block
+    struct sigaction previous_sigpipe {}; ///< SIGPIPE disposition before the pool ignored it, restored on destruction
+
+    SharedHeader& header() const;
+    Monitor* monitors() const;
+    RingEntry* ring() const;
+
+    /**
+     * @brief Forks a worker process in the given slot.
+     * @param worker Index of the worker.
+     * @return True if the worker was started.
+     */
+    bool spawn(std::size_t worker);
+
+    /**
+     * @brief Main loop of a worker process: run the games received through the pipe until it is closed, or
+     *        until a game was abandoned.
+     * @param worker Index of the worker.
+     * @param task_fd Read end of the worker's game id pipe.
+     */
+    [[noreturn]] void workerMain(std::size_t worker, int task_fd);
+
+    /**
+     * @brief Sends a game to an idle worker.
+     * @param worker Index of the worker.
+     * @param game_id Id of the game.
+     * @return True if the game was handed over.
+     */
+    bool assign(std::size_t worker, std::size_t game_id);
+
+    /**
+     * @brief Closes the worker's pipe, so it exits after its current game, and waits for it.
+     * @param worker Index of the worker.
+     */
+    void stop(std::size_t worker);
+
+    /**
+     * @brief Pushes an entry into the ring, waiting while the ring is full. Called in a worker.
+     * @param entry The entry to push.
+     */
+    void push(const RingEntry& entry);
+
+    /**
+     * @brief Pops all pushed entries from the ring. Called in the parent.
+     * @return The popped entries, in push order.
+     */
+    std::vector<RingEntry> drain();
+
+    /**
+     * @brief Locks the shared mutex, recovering it if its owner died while holding it.
+     */
+    void lock();
+};
+
+} // namespace Simulator_206480972_206899163
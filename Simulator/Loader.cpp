@@ -1,10 +1,11 @@
-#include "ArgsParser.h"
 #include "Loader.h"
+#include "GameManagerRegistrar.h"
+#include <algorithm>
+#include <filesystem>
 #include <iostream>
-#include <fstream>
+#include <stdexcept>
 #include <dirent.h> // For directory operations
-#include <dlfcn.h>  // For dynamic loading of shared 
-#include <iostream> // For input/output operations
+#include <dlfcn.h>  // For dynamic loading of shared
 #include <cstring>
 
 int HasSOExtension(const char *filename) {
@@ -13,52 +14,158 @@ int HasSOExtension(const char *filename) {
     return ext && strcmp(ext, ".so") == 0; // Check if the extension is .so
 }
 
-int LoadSharedObjects(const ParsedArgs& args) {
-    // This function loads shared objects based on the parsed arguments and returns an exit code.
-    // Determine the directory to load shared objects from based on the mode.
-    std::string so_dir;
-    if (args.mode == ParsedArgs::Mode::Comparative)
-        so_dir = args.game_managers_folder;
-    else if (args.mode == ParsedArgs::Mode::Competition)
-        so_dir = args.algorithms_folder;
-    else {
-        std::cerr << "Unsupported mode for loading shared objects." << std::endl;
-        return EXIT_FAILURE;
-    }
+std::vector<std::string> ListSOFilesInDir(const std::string& so_dir) {
+    // This function iterates through the directory and collects the path of each .so file.
+    std::vector<std::string> so_files;
     DIR *dir = opendir(so_dir.c_str());
     if (!dir) {
         std::cerr << "Failed to open directory: " << so_dir << std::endl;
-        return EXIT_FAILURE;
+        return so_files;
     }
-    int result = LoadSOFilesFromDir(dir, so_dir);
-    closedir(dir);
-    return result;
-}
-
-int LoadSOFilesFromDir(DIR* dir, const std::string& so_dir) {
-    // This function iterates through the directory and loads each .so file.
     struct dirent *entry;
     while ((entry = readdir(dir)) != NULL) {
         if (entry->d_type != DT_REG && entry->d_type != DT_LNK)
             continue; // Skip non-regular files
         if (!HasSOExtension(entry->d_name)) // Skip files without .so extension
             continue;
-        std::string so_path = so_dir + "/" + entry->d_name; // Construct the full path to the shared object file
-        void *handle = dlopen(so_path.c_str(), RTLD_LAZY);  // Load the shared object file
-        if (!handle) {
-            std::cerr << "dlopen failed for " << so_path << ": " << dlerror() << std::endl;
+        so_files.push_back(so_dir + "/" + entry->d_name); // Construct the full path to the shared object file
+    }
+    closedir(dir);
+    std::sort(so_files.begin(), so_files.end()); // Directory order is unspecified, keep ids deterministic
+    return so_files;
+}
+
+SharedObjectManager::~SharedObjectManager() {
+    // Unload whatever is still loaded, e.g. libraries of games that were never run.
+    // Libraries of abandoned games stay loaded until the process exits.
+    std::lock_guard<std::mutex> lock(load_mutex);
+    for (auto& library : libraries) {
+        if (library->abandoned.load()) {
             continue;
         }
-        run_func_t run_func = (run_func_t)dlsym(handle, "run"); // Get the address of the "run" function
-        // TODO: should not use dlsym!
-        char *error = dlerror();
-        if (error != NULL) {
-            std::cerr << "dlsym failed for " << so_path << ": " << error << std::endl;
+        unload(*library);
+    }
+}
+
+std::size_t SharedObjectManager::addLibrary(const std::string& path, Kind kind) {
+    // This function adds a library (once per path) without loading it
+    for (std::size_t id = 0; id < libraries.size(); ++id) {
+        if (libraries[id]->path == path && libraries[id]->kind == kind) {
+            return id;
+        }
+    }
+    auto library = std::make_unique<Library>();
+    library->path = path;
+    library->name = std::filesystem::path(path).stem().string();
+    library->kind = kind;
+    libraries.push_back(std::move(library));
+    return libraries.size() - 1;
+}
+
+void SharedObjectManager::reserve(std::size_t id) {
+    // This function counts one more scheduled game that needs the library
+    libraries.at(id)->pending.fetch_add(1, std::memory_order_relaxed);
+}
+
+const AlgorithmRegistrar::AlgorithmAndPlayerFactories& SharedObjectManager::acquireAlgorithm(std::size_t id) {
+    // This function returns the factories of an algorithm library, loading it on first use
+    Library& library = *libraries.at(id);
+    std::lock_guard<std::mutex> lock(load_mutex);
+    load(library);
+    return *library.algorithm;
+}
+
+const GameManagerFactory& SharedObjectManager::acquireGameManager(std::size_t id) {
+    // This function returns the factory of a game manager library, loading it on first use
+    Library& library = *libraries.at(id);
+    std::lock_guard<std::mutex> lock(load_mutex);
+    load(library);
+    return library.game_manager;
+}
+
+void SharedObjectManager::release(std::size_t id) {
+    // This function releases one scheduled game; the last release unloads the library
+    Library& library = *libraries.at(id);
+    if (library.pending.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        std::lock_guard<std::mutex> lock(load_mutex);
+        unload(library);
+    }
+}
+
+void SharedObjectManager::abandon(std::size_t id) {
+    // This function pins the library; its reservation is never released, so it is not unloaded by release either
+    libraries.at(id)->abandoned.store(true);
+}
+
+const std::string& SharedObjectManager::name(std::size_t id) const {
+    // This function returns the name of the library
+    return libraries.at(id)->name;
+}
+
+const std::string& SharedObjectManager::path(std::size_t id) const {
+    // This function returns the path of the library
+    return libraries.at(id)->path;
+}
+
+std::size_t SharedObjectManager::count() const {
+    // This function returns the number of added libraries
+    return libraries.size();
+}
+
+void SharedObjectManager::load(Library& library) {
+    // This function dlopens the library once and moves its registered factories into the manager.
+    if (library.attempted) {
+        if (!library.handle) {
+            throw std::runtime_error("Shared object " + library.path + " is not loaded");
+        }
+        return;
+    }
+    library.attempted = true; // never load a library twice, even after a failure
+    auto& algorithm_registrar = AlgorithmRegistrar::getAlgorithmRegistrar();
+    auto& game_manager_registrar = GameManagerRegistrar::getGameManagerRegistrar();
+    if (library.kind == Kind::Algorithm) {
+        algorithm_registrar.createAlgorithmFactoryEntry(library.name);
+    } else {
+        game_manager_registrar.createGameManagerEntry(library.name);
+    }
+    std::size_t managers_before = game_manager_registrar.count();
+    void *handle = dlopen(library.path.c_str(), RTLD_LAZY);  // Load the shared object file
+    if (!handle) {
+        std::string error = dlerror();
+        if (library.kind == Kind::Algorithm) algorithm_registrar.removeLast();
+        else game_manager_registrar.removeLast();
+        throw std::runtime_error("dlopen failed for " + library.path + ": " + error);
+    }
+    if (library.kind == Kind::Algorithm) {
+        try {
+            algorithm_registrar.validateLastRegistration();
+        } catch (const AlgorithmRegistrar::BadRegistrationException&) {
+            algorithm_registrar.removeLast();
             dlclose(handle);
-            continue;
+            throw std::runtime_error("Shared object " + library.path + " did not register a Player and a TankAlgorithm");
         }
-        run_func(); // Call the run function from the shared object
-        dlclose(handle); // Close the shared object handle
+        const std::size_t last = algorithm_registrar.count() - 1;
+        library.algorithm = std::make_unique<AlgorithmRegistrar::AlgorithmAndPlayerFactories>(algorithm_registrar.getAt(last));
+        algorithm_registrar.removeLast();
+    } else {
+        if (game_manager_registrar.count() != managers_before + 1) {
+            game_manager_registrar.removeLast();
+            dlclose(handle);
+            throw std::runtime_error("Shared object " + library.path + " did not register a GameManager");
+        }
+        library.game_manager = game_manager_registrar.getAt(static_cast<int>(game_manager_registrar.count() - 1));
+        game_manager_registrar.removeLast();
+    }
+    library.handle = handle;
+}
+
+void SharedObjectManager::unload(Library& library) {
+    // This function destroys the factories (their code lives in the library) before closing the library
+    if (!library.handle) {
+        return;
     }
-    return EXIT_SUCCESS;
+    library.algorithm.reset();
+    library.game_manager = nullptr;
+    dlclose(library.handle);
+    library.handle = nullptr;
 }
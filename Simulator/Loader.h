@@ -1,11 +1,18 @@
 #pragma once
 
 #include "ArgsParser.h"
-#include <dirent.h>
+#include "AlgorithmRegistrar.h"
+#include "../common/AbstractGameManager.h"
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
 
 /**
  * @file Loader.h
- * @brief Declares functions for loading and executing shared object (.so) files.
+ * @brief Declares utilities and the lifecycle manager for loading shared object (.so) files.
  */
 
 /**
@@ -16,24 +23,148 @@
 int HasSOExtension(const char *filename);
 
 /**
- * @brief Loads shared objects from the directory specified in ParsedArgs and executes their run function.
- * @param args ParsedArgs structure containing mode and relevant directories.
- * @return EXIT_SUCCESS on success, EXIT_FAILURE on error.
- */
-int LoadSharedObjects(const ParsedArgs& args);
-
-/**
- * @brief Loads and executes all .so files in the given directory.
- * @param dir Pointer to opened DIR structure.
+ * @brief Lists all .so files in the given directory, sorted by name.
  * @param so_dir Directory path as a string.
- * @return EXIT_SUCCESS on success, EXIT_FAILURE on error.
+ * @return Full paths of the .so files, empty if the directory cannot be opened.
  */
-int LoadSOFilesFromDir(DIR* dir, const std::string& so_dir);
+std::vector<std::string> ListSOFilesInDir(const std::string& so_dir);
 
 /**
- * @brief Function pointer type for the run function in shared objects.
+ * @class SharedObjectManager
+ * @brief Loads algorithm and game manager .so files lazily and unloads them when no scheduled game needs them.
+ *
+ * Libraries are first added (not loaded). While scheduling, every game reserves the libraries it uses,
+ * which counts the outstanding games per library. A library is dlopened the first time a game acquires it,
+ * its factories are moved out of the registrar into the manager, and it is dlclosed as soon as the last
+ * outstanding game releases it. A library is never loaded twice.
  */
-typedef void (*run_func_t)(void);
+class SharedObjectManager {
+public:
+    /**
+     * @brief The kind of a shared object, which decides the registrar it registers into.
+     */
+    enum class Kind { Algorithm, GameManager };
+
+    /**
+     * @class Lease
+     * @brief Releases a reserved library when going out of scope, even if the game failed.
+     */
+    class Lease {
+        SharedObjectManager& manager; ///< The manager owning the library
+        std::size_t id;               ///< Id of the leased library
+        bool armed = true;            ///< False once the lease was abandoned
+    public:
+        Lease(SharedObjectManager& manager, std::size_t id) : manager(manager), id(id) {}
+        Lease(const Lease&) = delete;
+        Lease& operator=(const Lease&) = delete;
+        ~Lease() { if (armed) manager.release(id); }
+
+        /**
+         * @brief Gives up the lease without releasing it, for a game that still runs the library's code.
+         */
+        void abandon() { armed = false; manager.abandon(id); }
+    };
+
+    SharedObjectManager() = default;
+
+    // Rule of 5
+    SharedObjectManager(const SharedObjectManager&) = delete;
+    SharedObjectManager& operator=(const SharedObjectManager&) = delete;
+    SharedObjectManager(SharedObjectManager&&) = delete;
+    SharedObjectManager& operator=(SharedObjectManager&&) = delete;
+
+    /**
+     * @brief Unloads any library that is still loaded, except those of abandoned games.
+     */
+    ~SharedObjectManager();
+
+    /**
+     * @brief Adds a library without loading it. Adding the same path twice returns the same id.
+     *        Must be called before any game is scheduled.
+     * @param path Path of the .so file.
+     * @param kind Kind of the library.
+     * @return Id of the library.
+     */
+    std::size_t addLibrary(const std::string& path, Kind kind);
+
+    /**
+     * @brief Counts one more scheduled game that uses the library. Must be called before games run.
+     * @param id Id of the library.
+     */
+    void reserve(std::size_t id);
+
+    /**
+     * @brief Returns the algorithm factories of the library, loading it on first use.
+     * @param id Id of an algorithm library.
+     * @throws std::runtime_error if the library cannot be loaded or did not register correctly.
+     */
+    const AlgorithmRegistrar::AlgorithmAndPlayerFactories& acquireAlgorithm(std::size_t id);
+
+    /**
+     * @brief Returns the game manager factory of the library, loading it on first use.
+     * @param id Id of a game manager library.
+     * @throws std::runtime_error if the library cannot be loaded or did not register correctly.
+     */
+    const GameManagerFactory& acquireGameManager(std::size_t id);
+
+    /**
+     * @brief Marks one scheduled game that used the library as finished, unloading it after the last one.
+     * @param id Id of the library.
+     */
+    void release(std::size_t id);
+
+    /**
+     * @brief Keeps the library loaded for the rest of the process, since an abandoned game may still run its code.
+     * @param id Id of the library.
+     */
+    void abandon(std::size_t id);
+
+    /**
+     * @brief Returns the name of the library (file name without the .so extension).
+     * @param id Id of the library.
+     */
+    const std::string& name(std::size_t id) const;
+
+    /**
+     * @brief Returns the path of the library's .so file.
+     * @param id Id of the library.
+     */
+    const std::string& path(std::size_t id) const;
+
+    /**
+     * @brief Returns the number of added libraries.
+     */
+    std::size_t count() const;
+
+private:
+    /**
+     * @brief State of a single shared object.
+     */
+    struct Library {
+        std::string path;                     ///< Path of the .so file
+        std::string name;                     ///< File name without extension
+        Kind kind;                            ///< Registrar the library registers into
+        void* handle = nullptr;               ///< dlopen handle while loaded
+        bool attempted = false;               ///< True once the library was loaded (or failed to load)
+        std::atomic<bool> abandoned{false};   ///< True if an abandoned game may still use the library
+        std::atomic<std::size_t> pending{0};  ///< Scheduled games that did not release the library yet
+        std::unique_ptr<AlgorithmRegistrar::AlgorithmAndPlayerFactories> algorithm; ///< Algorithm factories
+        GameManagerFactory game_manager;      ///< Game manager factory
+    };
 
+    std::vector<std::unique_ptr<Library>> libraries; ///< All added libraries, indexed by id
+    std::mutex load_mutex; ///< Serializes dlopen/dlclose, since registration goes through the global registrars
 
+    /**
+     * @brief Loads the library once and moves its factories out of the registrar. Called with load_mutex held.
+     * @param library The library to load.
+     * @throws std::runtime_error on failure.
+     */
+    void load(Library& library);
 
+    /**
+     * @brief Drops the factories of the library and dlcloses it. Called with load_mutex held.
+     * @param library The library to unload.
+     */
+    void unload(Library& library);
+};
@@ -0,0 +1,38 @@
+#include "MapCache.h"
+#include "MapParser.h"
+#include "../GameBoardSatelliteView.h"
+#include <filesystem>
+#include <vector>
+
+namespace Simulator_206480972_206899163 {
+
+CachedMap MapCache::get(const std::string& path) {
+    // This function returns the cached map, parsing the file only for the first caller
+    std::shared_ptr<Entry> entry;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto& slot = entries[canonicalPath(path)];
+        if (!slot) {
+            slot = std::make_shared<Entry>();
+        }
+        entry = slot;
+    }
+    std::call_once(entry->parsed, [&entry, &path]() {
+        std::vector<std::string> errors;
+        std::shared_ptr<const MapData> data = readMapFile(path, errors);
+        if (data) {
+            entry->map.view = std::make_shared<const GameBoardSatelliteView>(data.get());
+            entry->map.data = std::move(data);
+        }
+    });
+    return entry->map;
+}
+
+std::string MapCache::canonicalPath(const std::string& path) {
+    // This function resolves the path so that different spellings of the same file share an entry
+    std::error_code error;
+    auto canonical = std::filesystem::weakly_canonical(std::filesystem::path(path), error);
+    return error ? path : canonical.string();
+}
+
+} // namespace Simulator_206480972_206899163
@@ -0,0 +1,71 @@
+#pragma once
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include "../UserCommon/MapData.h"
+#include "../common/SatelliteView.h"
+
+/**
+ * @file MapCache.h
+ * @brief Declares a thread-safe cache of parsed, immutable game maps.
+ */
+
+namespace Simulator_206480972_206899163 {
+
+/**
+ * @struct CachedMap
+ * @brief A parsed map and a satellite view over it, shared by every game played on the map.
+ *        Both are empty (nullptr) if the map could not be parsed.
+ */
+struct CachedMap {
+    std::shared_ptr<const MapData> data;        ///< The parsed map
+    std::shared_ptr<const SatelliteView> view;  ///< Initial-state view over data
+};
+
+/**
+ * @class MapCache
+ * @brief Parses every map file exactly once per run and hands out shared, immutable copies of it.
+ *
+ * Entries are keyed by the canonical path of the map file. The cache mutex is held only to find or
+ * create an entry; the parsing itself runs once per entry (std::call_once), so different maps are
+ * parsed concurrently while workers asking for the same map wait for the single parse.
+ */
+class MapCache {
+public:
+    MapCache() = default;
+
+    // Rule of 5
+    MapCache(const MapCache&) = delete;
+    MapCache& operator=(const MapCache&) = delete;
+    MapCache(MapCache&&) = delete;
+    MapCache& operator=(MapCache&&) = delete;
+    ~MapCache() = default;
+
+    /**
+     * @brief Returns the parsed map, parsing it on the first request.
+     * @param path Path of the map file.
+     * @return The cached map, with nullptr members if the map is invalid.
+     */
+    CachedMap get(const std::string& path);
+
+private:
+    /**
+     * @brief A single cache slot, filled exactly once.
+     */
+    struct Entry {
+        std::once_flag parsed; ///< Guards the single parse of the map
+        CachedMap map;         ///< The parsed map and its view
+    };
+
+    std::mutex mutex; ///< Guards entries
+    std::unordered_map<std::string, std::shared_ptr<Entry>> entries; ///< Canonical path -> entry
+
+    /**
+     * @brief Returns the canonical form of the path, or the path itself if it cannot be resolved.
+     * @param path Path of the map file.
+     */
+    static std::string canonicalPath(const std::string& path);
+};
+
+} // namespace Simulator_206480972_206899163
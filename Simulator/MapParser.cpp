@@ -2,6 +2,8 @@
 #include "GameBoardSatelliteView.h"
 #include "common/SatelliteView.h"
 #include <fstream>
+#include <iostream>
+#include <memory>
 
 // This file contains functions for parsing map files.
 
@@ -54,7 +56,7 @@ int parseKeyValue(const std::string& line, std::string key , std::vector<std::st
     }
 }
 
-MapData readMapFile(const std::string& filename, std::vector<std::string>& errors) {
+std::unique_ptr<MapData> readMapFile(const std::string& filename, std::vector<std::string>& errors) {
     // Reads and parses the game board from a file.
     std::ifstream input_file(filename);
     std::vector<std::string> header_errors;
@@ -104,7 +106,7 @@ MapData readMapFile(const std::string& filename, std::vector<std::string>& error
             errorFile.close();
         } else { std::cerr << "Failed to write to input_errors.txt" << std::endl;}
     }
-    return MapData(max_steps, num_shells, rows, cols, grid);
+    return std::make_unique<MapData>(max_steps, num_shells, rows, cols, std::move(grid));
 }
 
 bool readHeadersLine(std::ifstream& input_file,int& maxSteps, int& numShells, int& rows, int& cols, std::vector<std::string>& header_errors) {
@@ -1,4 +1,5 @@
 #pragma once
+#include <memory>
 #include <string>
 #include <vector>
 #include "Simulator.h"
@@ -20,7 +21,7 @@
  * @param errors Vector to store any error messages encountered during parsing.
  * @return A unique pointer to MapData if successful, nullptr otherwise.
  */
-MapData readMapFile(const std::string& filename, std::vector<std::string>& errors);
+std::unique_ptr<MapData> readMapFile(const std::string& filename, std::vector<std::string>& errors);
 
 /**
  * @brief Trims leading and trailing whitespace from a string.
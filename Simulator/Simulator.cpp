@@ -4,16 +4,28 @@
 #include "Loader.h"
 #include "GameManagerRegistrar.h"
 #include "AlgorithmRegistrar.h"
-#include "../GameBoardSatelliteView.h"
+#include "WorkStealingPool.h"
+#include "GameResultWriter.h"
+#include "MapCache.h"
+#include "CompetitionScoreTable.h"
+#include "CompetitionCheckpoint.h"
+#include "GameCostModel.h"
+#include "IsolatedWorkerPool.h"
+#include "CompetitionShard.h"
+#include "GameResultCache.h"
+#include "../UserCommon/BulkSatelliteView.h"
+#include "../UserCommon/FastForwardGameManager.h"
 
 #include <map>
 #include <filesystem>
 #include <fstream>
 #include <algorithm>
+#include <chrono>
 #include <cctype>
 #include <vector>
 #include <string>
 #include <set>
+#include <stdexcept>
 #include <dirent.h> // For directory operations
 #include <dlfcn.h>  // For dynamic loading of shared 
 #include <iostream> // For input/output operations
@@ -30,6 +42,8 @@ int main(int argc, char* argv[]) {
             simulator.runComparativeMode(args);
         } else if (args.mode == ParsedArgs::Mode::Competition) {
             simulator.runCompetitionMode(args);
+        } else if (args.mode == ParsedArgs::Mode::Merge) {
+            simulator.runMergeMode(args);
         }
 
     } catch (const std::exception& e) {
@@ -44,82 +58,415 @@ Simulator::Simulator() {
 }
 
 void Simulator::runComparativeMode(const ParsedArgs& args) {
-    // Implementation for comparative mode
-    // Load game managers and algorithms, run simulations, etc.
-    std::vector<std::string> errors;
-    auto map_data = readMapFile(args.game_map, errors);
-    int player1_index = 1;
-    int player2_index = 2;
-
-    auto& play_and_algorithm_registrar = AlgorithmRegistrar::getAlgorithmRegistrar();
-    auto& game_managers_registrar = GameManagerRegistrar::getGameManagerRegistrar();
-
-    // run all game manager, and give each one the same algorithms and map
-    auto algorithm1 = play_and_algorithm_registrar.getAlgorithmRegistrar().getAt(0);
-    auto algorithm2 = play_and_algorithm_registrar.getAlgorithmRegistrar().getAt(1);
-    auto satellite_view = GameBoardSatelliteView(&map_data);
-
-    for (auto& factory : game_managers_registrar) {
-        auto manager = factory(args.verbose); // Create a game manager instance
-        auto player1 = *algorithm1.getPlayerFactory()(player1_index, map_info.length, 
-                                                      map_info.length, map_info.max_steps, map_info.num_shells);
-        auto player2 = *algorithm2.getPlayerFactory()(player2_index, map_info.length, 
-                                                      map_info.length, map_info.max_steps, map_info.num_shells);
-
-        auto game_result = manager->run(map_data->cols, map_data->rows, satellite_view,
-                                        map_info.max_steps, map_info.num_shells, player1, player2,
-                                        algorithm1.getTankAlgorithmFactory(), algorithm2.getTankAlgorithmFactory());
-        write_game_result_to_file(game_result);
+    // Runs every game manager in the folder on the same map with the same two algorithms.
+    // Each game manager run is a task of the worker pool, the main thread gathers the results.
+    MapCache map_cache;
+    CachedMap map = map_cache.get(args.game_map);
+    if (!map.data) {
+        std::cerr << "Invalid map file: " << args.game_map << std::endl;
+        return;
+    }
+    const MapData& map_data = *map.data;
+
+    // nothing is loaded here, libraries are loaded by the first game that needs them
+    SharedObjectManager libraries;
+    std::vector<size_t> game_manager_ids;
+    for (const auto& so_path : ListSOFilesInDir(args.game_managers_folder)) {
+        game_manager_ids.push_back(libraries.addLibrary(so_path, SharedObjectManager::Kind::GameManager));
+    }
+    // algorithm1 and algorithm2 may point to the same .so, in which case both get the same id
+    const size_t algorithm1_id = libraries.addLibrary(args.algorithm1, SharedObjectManager::Kind::Algorithm);
+    const size_t algorithm2_id = libraries.addLibrary(args.algorithm2, SharedObjectManager::Kind::Algorithm);
+    for (size_t game_manager_id : game_manager_ids) {
+        libraries.reserve(game_manager_id);
+        libraries.reserve(algorithm1_id);
+        libraries.reserve(algorithm2_id);
+    }
+    const SatelliteView& satellite_view = *map.view;
+
+    // one preallocated slot per game manager, each task writes only its own slot
+    std::vector<ComparativeRun> runs(game_manager_ids.size());
+    std::vector<WorkStealingPool::Task> tasks;
+    tasks.reserve(runs.size());
+    for (size_t i = 0; i < runs.size(); ++i) {
+        tasks.emplace_back([&args, &map_data, &satellite_view, &libraries, &game_manager_ids, algorithm1_id, algorithm2_id, &runs, i]() {
+            ComparativeRun& run = runs[i];
+            auto& algorithm1 = libraries.acquireAlgorithm(algorithm1_id);
+            auto& algorithm2 = libraries.acquireAlgorithm(algorithm2_id);
+            run.game_manager = libraries.acquireGameManager(game_manager_ids[i])(args.verbose);
+            configureGameManager(*run.game_manager, args);
+            run.result = runGame(*run.game_manager, map_data, satellite_view, algorithm1, algorithm2);
+        });
+    }
+    WorkStealingPool pool(static_cast<size_t>(args.num_threads), std::move(tasks));
+    pool.run(); // the main thread only waits for the workers to join
+
+    {
+        std::vector<std::pair<std::string, GameResult>> results;
+        results.reserve(runs.size());
+        for (size_t i = 0; i < runs.size(); ++i) {
+            if (runs[i].game_manager) { // skip game managers that failed to load
+                results.emplace_back(libraries.name(game_manager_ids[i]), std::move(runs[i].result));
+            }
+        }
+        const size_t rows = static_cast<size_t>(map_data.length);
+        const size_t cols = static_cast<size_t>(map_data.height);
+        GameResultWriter writer;
+        // the game managers are still alive here, so final states that point into them remain valid
+        writer.writeComparativeResults(args.game_managers_folder, args.game_map, args.algorithm1, args.algorithm2, results,
+                                       [rows, cols](const SatelliteView& view) { return renderGameState(view, rows, cols); });
+    }
+    // instances must be destroyed while their libraries are still loaded, only then the libraries are released
+    runs.clear();
+    for (size_t game_manager_id : game_manager_ids) {
+        libraries.release(game_manager_id);
+        libraries.release(algorithm1_id);
+        libraries.release(algorithm2_id);
     }
 }
 
+std::vector<std::string> Simulator::renderGameState(const SatelliteView& view, size_t rows, size_t cols) {
+    // This function renders a final game state into one string per board row
+    std::vector<std::string> lines(rows, std::string(cols, ' '));
+    if (const auto* bulk = dynamic_cast<const BulkSatelliteView*>(&view)) {
+        std::string cells(rows * cols, ' ');
+        bulk->copyRows(cells.data(), cols, rows, cols);
+        for (size_t x = 0; x < rows; ++x) {
+            lines[x].assign(cells, x * cols, cols);
+        }
+        return lines;
+    }
+    for (size_t x = 0; x < rows; ++x) {
+        for (size_t y = 0; y < cols; ++y) {
+            lines[x][y] = view.getObjectAt(x, y);
+        }
+    }
+    return lines;
+}
+
 void Simulator::runCompetitionMode(const ParsedArgs& args) {
-    // we expect to have exactly 2 players/algorithms
-    auto& play_and_algorithm_registrar = AlgorithmRegistrar::getAlgorithmRegistrar();
-    // we expect to have exactly one game manager
-    auto& game_managers_registrar = GameManagerRegistrar::getGameManagerRegistrar();
+    // nothing is loaded here, libraries are loaded by the first game that needs them
+    SharedObjectManager libraries;
+    std::vector<size_t> algorithm_ids;
+    for (const auto& so_path : ListSOFilesInDir(args.algorithms_folder)) {
+        algorithm_ids.push_back(libraries.addLibrary(so_path, SharedObjectManager::Kind::Algorithm));
+    }
+    const size_t game_manager_id = libraries.addLibrary(args.game_manager_so, SharedObjectManager::Kind::GameManager);
     std::vector<std::string> map_names = getAllMapNames(args.game_maps_folder);
-    // we calculate the matchups. each matchup contains a map index as a key, and a pair of 
-    // two players/algorithms as the value
-    std::map <int, std::vector<std::pair<int, int>>> matchups;
-    for (int k = 0; k < map_names.size(); ++k) {
-        matchups[k] = pairs_for_map((int)play_and_algorithm_registrar.count(), k);
-    }
-
-    // create the game manager
-    auto game_manager = game_managers_registrar.getAt(0)();
-
-    // run matchups for each map
-    for (auto& matchup : matchups) {
-        // read the map from the list 
-	std::vector<std::string> errors;
-        auto map_info = readMapFile(map_names[matchup.first], errors);
-        
-        // on the given map, run all matchups of all players pairs
-        for (auto [player1_index, player2_index] : matchup.second) {
-            auto algorithm_player1 = play_and_algorithm_registrar.getAlgorithmRegistrar().getAt(player1_index);
-            auto algorithm_player2 = play_and_algorithm_registrar.getAlgorithmRegistrar().getAt(player2_index);
-
-            auto player1 = *algorithm_player1.getPlayerFactory()(player1_index, map_info.length,
-                map_info->length, map_info.max_steps, map_info.num_shells);
-            auto player2 = *algorithm_player2.getPlayerFactory()(player2_index, map_info.length,
-                map_info.length, map_info.max_steps, map_info.num_shells);
-
-            auto game_result = game_manager->run(
-                map_info.length,
-                map_info.height,
-                *(map_info.view),
-                map_info.max_steps,
-                map_info.num_shells,
-                player1,
-                player2,
-                algorithm_player1.getTankAlgorithmFactory(),
-                algorithm_player2.getTankAlgorithmFactory()
-            );
-
-            write_game_result_to_file(game_result);
+
+    // every map is parsed once, by the first game that needs it, and then shared by all its games
+    std::vector<std::string> map_paths;
+    map_paths.reserve(map_names.size());
+    for (const auto& map_name : map_names) {
+        map_paths.push_back((std::filesystem::path(args.game_maps_folder) / map_name).string());
+    }
+    MapCache map_cache;
+
+    // we calculate the matchups. each game is a map index and a pair of two players/algorithms.
+    // the game id is the index in this list, which is stable as long as the folders do not change.
+    std::vector<CompetitionGame> games;
+    for (size_t k = 0; k < map_names.size(); ++k) {
+        for (auto [player1_index, player2_index] : pairs_for_map((int)algorithm_ids.size(), (int)k)) {
+            games.push_back(CompetitionGame{k, player1_index, player2_index});
+        }
+    }
+
+    // the result table is known in advance: one slot per game id, written by exactly one worker
+    CompetitionScoreTable score_table(games.size(), algorithm_ids.size());
+
+    // the content of every file that decides a game is hashed once; the hashes identify the schedule of a
+    // checkpoint and key the result cache
+    const std::string game_manager_hash = GameResultCache::hashFile(args.game_manager_so);
+    std::vector<std::string> algorithm_hashes;
+    std::vector<std::string> algorithm_identities;
+    for (size_t id : algorithm_ids) {
+        algorithm_hashes.push_back(GameResultCache::hashFile(libraries.path(id)));
+        algorithm_identities.push_back(libraries.name(id) + " " + algorithm_hashes.back());
+    }
+    std::vector<std::string> map_hashes;
+    std::vector<std::string> map_identities;
+    for (size_t k = 0; k < map_paths.size(); ++k) {
+        map_hashes.push_back(GameResultCache::hashFile(map_paths[k]));
+        map_identities.push_back(map_names[k] + " " + map_hashes.back());
+    }
+    const std::string schedule_identity = CompetitionCheckpoint::scheduleIdentity(
+        std::filesystem::path(args.game_manager_so).filename().string() + " " + game_manager_hash, algorithm_identities, map_identities);
+
+    // games recorded by a previous (interrupted) run of the same schedule are restored instead of being played again
+    if (!args.resume_file.empty()) {
+        for (const CheckpointEntry& entry : CompetitionCheckpoint::load(args.resume_file, games.size(), schedule_identity)) {
+            const CompetitionGame& game = games[entry.game_id];
+            if (!score_table.getRecord(entry.game_id).finished) {
+                score_table.recordGame(entry.game_id, game.player1_index, game.player2_index,
+                                       entry.winner, entry.reason, entry.rounds, 0);
+            }
+        }
+    }
+    // a resume file of another schedule (e.g. a rebuilt library) is kept as it is, this run gets a checkpoint of its own
+    std::string checkpoint_path = args.resume_file;
+    if (!checkpoint_path.empty() && CompetitionCheckpoint::belongsToOther(checkpoint_path, games.size(), schedule_identity)) {
+        std::cerr << "Resume file '" << checkpoint_path << "' is left unchanged, this run writes a new checkpoint.\n";
+        checkpoint_path.clear();
+    }
+    if (checkpoint_path.empty()) {
+        checkpoint_path = (std::filesystem::path(args.algorithms_folder) / ("competition_checkpoint_" + std::to_string(
+            std::chrono::system_clock::now().time_since_epoch().count()) + ".txt")).string();
+    }
+    CompetitionCheckpoint checkpoint(checkpoint_path, games.size(), schedule_identity);
+
+    // with shard=i/n only the games whose id is i modulo n are played; every shard sees the same game ids
+    ShardSpec shard;
+    if (!args.shard.empty()) {
+        ShardSpec::parse(args.shard, shard);
+    }
+
+    // games whose game manager, algorithms and map are unchanged since an earlier run reuse the cached result.
+    // with -verbose every game is played, since the game manager writes its output files while playing.
+    GameResultCache result_cache((std::filesystem::path(args.algorithms_folder) / "competition_result_cache.txt").string());
+    // a file whose content changed since its last run drops its entries, they can never match again
+    result_cache.trackFile(args.game_manager_so, game_manager_hash);
+    for (size_t i = 0; i < algorithm_ids.size(); ++i) {
+        result_cache.trackFile(libraries.path(algorithm_ids[i]), algorithm_hashes[i]);
+    }
+    for (size_t k = 0; k < map_paths.size(); ++k) {
+        result_cache.trackFile(map_paths[k], map_hashes[k]);
+    }
+    auto cache_key = [&games, &game_manager_hash, &algorithm_hashes, &map_hashes](size_t game_id) {
+        const CompetitionGame& game = games[game_id];
+        return ResultCacheKey{game_manager_hash, algorithm_hashes[game.player1_index],
+                              algorithm_hashes[game.player2_index], map_hashes[game.map_index]};
+    };
+    size_t cached_games = 0;
+    for (size_t game_id = 0; game_id < games.size() && !args.verbose; ++game_id) {
+        CachedResult cached;
+        if (shard.contains(game_id) && !score_table.getRecord(game_id).finished && result_cache.lookup(cache_key(game_id), cached)) {
+            score_table.recordGame(game_id, games[game_id].player1_index, games[game_id].player2_index,
+                                   cached.winner, cached.reason, cached.rounds, 0);
+            ++cached_games;
+        }
+    }
+    if (cached_games > 0) {
+        std::cout << "Reused " << cached_games << " cached game results" << std::endl;
+    }
+
+    // estimate the cost of every remaining game and schedule the longest ones first, so that an expensive
+    // game does not start last and dominate the total run time. maps are parsed here once, through the cache.
+    GameCostModel cost_model((std::filesystem::path(args.algorithms_folder) / "competition_history.txt").string());
+    std::vector<std::pair<double, size_t>> schedule; // (estimated cost, game id)
+    for (size_t game_id = 0; game_id < games.size(); ++game_id) {
+        if (!shard.contains(game_id) || score_table.getRecord(game_id).finished) {
+            continue;
         }
+        const CompetitionGame& game = games[game_id];
+        CachedMap map = map_cache.get(map_paths[game.map_index]);
+        double cost = map.data ? cost_model.estimate(*map.data, libraries.name(algorithm_ids[game.player1_index]),
+                                                     libraries.name(algorithm_ids[game.player2_index])) : 0;
+        schedule.emplace_back(cost, game_id);
     }
+    std::stable_sort(schedule.begin(), schedule.end(), [](const auto& a, const auto& b) { return a.first > b.first; });
+
+    // budgets that keep a single slow or hanging game from holding up the whole competition
+    WatchdogLimits limits;
+    limits.game_budget = std::chrono::milliseconds(args.game_timeout_ms);
+    limits.action_budget = std::chrono::milliseconds(args.action_timeout_ms);
+    limits.timeout_is_tie = args.timeout_is_tie;
+
+    // runs a single game and returns its outcome, in a worker thread or in an isolated worker process
+    auto play_game = [&args, &map_paths, &map_cache, &libraries, &algorithm_ids, &games, &limits, game_manager_id](
+                         size_t game_id, const std::shared_ptr<GameWatchdog::Monitor>& monitor) {
+        const CompetitionGame& game = games[game_id];
+        // the leases are declared first, so the libraries are released only after every instance is gone
+        SharedObjectManager::Lease game_manager_lease(libraries, game_manager_id);
+        SharedObjectManager::Lease player1_lease(libraries, algorithm_ids[game.player1_index]);
+        SharedObjectManager::Lease player2_lease(libraries, algorithm_ids[game.player2_index]);
+        CachedMap map = map_cache.get(map_paths[game.map_index]);
+        if (!map.data) {
+            throw std::runtime_error("invalid map file " + map_paths[game.map_index]);
+        }
+        // the game owns copies of everything it uses: past its budget it is abandoned and may outlive this task
+        AlgorithmRegistrar::AlgorithmAndPlayerFactories algorithm_player1 = libraries.acquireAlgorithm(algorithm_ids[game.player1_index]);
+        AlgorithmRegistrar::AlgorithmAndPlayerFactories algorithm_player2 = libraries.acquireAlgorithm(algorithm_ids[game.player2_index]);
+        // every game gets its own game manager and players, instances are never shared between workers
+        std::shared_ptr<AbstractGameManager> game_manager = libraries.acquireGameManager(game_manager_id)(args.verbose);
+        configureGameManager(*game_manager, args);
+        GameWatchdog watchdog(limits, monitor);
+        auto start = std::chrono::steady_clock::now();
+        auto game_result = watchdog.run([game_manager, map, algorithm_player1, algorithm_player2, watchdog]() {
+            GameResult result = runGame(*game_manager, *map.data, *map.view, algorithm_player1, algorithm_player2,
+                                        watchdog.enabled() ? &watchdog : nullptr);
+            result.gameState.reset(); // the final state may point into the game manager, drop it while it is alive
+            return result;
+        });
+        auto duration = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start);
+        if (watchdog.abandoned()) {
+            // the abandoned game still runs library code, so its libraries must stay loaded
+            std::cerr << "Game " << game_id << " exceeded its time budget and was abandoned" << std::endl;
+            game_manager_lease.abandon();
+            player1_lease.abandon();
+            player2_lease.abandon();
+        }
+        GameRecord record;
+        record.player1_algorithm = game.player1_index;
+        record.player2_algorithm = game.player2_index;
+        record.winner = game_result.winner;
+        record.reason = game_result.reason;
+        record.rounds = game_result.rounds;
+        record.duration_ns = duration.count();
+        record.forfeited = watchdog.forfeited();
+        record.abandoned = watchdog.abandoned(); // an isolated worker exits after reporting it, ending the game
+        return record;
+    };
+    auto record_game = [&score_table, &checkpoint](size_t game_id, const GameRecord& record) {
+        score_table.recordGame(game_id, record.player1_algorithm, record.player2_algorithm,
+                               record.winner, record.reason, record.rounds, record.duration_ns, record.forfeited);
+        checkpoint.append(CheckpointEntry{game_id, record.winner, record.reason, record.rounds});
+    };
+
+    // every remaining game reserves the libraries it uses
+    for (const auto& [cost, game_id] : schedule) {
+        const CompetitionGame& game = games[game_id];
+        libraries.reserve(game_manager_id);
+        libraries.reserve(algorithm_ids[game.player1_index]);
+        libraries.reserve(algorithm_ids[game.player2_index]);
+    }
+
+    if (args.isolate) {
+        // everything is loaded before forking, so the worker processes inherit it and stay warm.
+        // the extra reservation keeps a worker from unloading a library it may still need for a later game.
+        for (size_t id = 0; id < libraries.count(); ++id) {
+            libraries.reserve(id);
+            try {
+                if (id == game_manager_id) libraries.acquireGameManager(id);
+                else libraries.acquireAlgorithm(id);
+            } catch (const std::exception& e) {
+                std::cerr << "Error: " << e.what() << std::endl; // its games fail in the workers
+            }
+        }
+        std::vector<size_t> game_ids;
+        game_ids.reserve(schedule.size());
+        for (const auto& [cost, game_id] : schedule) {
+            game_ids.push_back(game_id);
+        }
+        IsolatedWorkerPool pool(static_cast<size_t>(args.num_threads), play_game);
+        pool.run(game_ids, record_game, [&games, &record_game](size_t game_id, int offender) {
+            // a crash is a forfeit of the player whose code was running, or a tie if that is unknown
+            GameRecord record;
+            record.player1_algorithm = games[game_id].player1_index;
+            record.player2_algorithm = games[game_id].player2_index;
+            record.winner = offender == 0 ? 0 : 3 - offender;
+            record.reason = GameResult::MAX_STEPS;
+            record.forfeited = true;
+            record_game(game_id, record);
+        });
+        for (size_t id = 0; id < libraries.count(); ++id) {
+            libraries.release(id);
+        }
+    } else {
+        // every remaining game becomes a single task of the worker pool
+        std::vector<WorkStealingPool::Task> tasks;
+        tasks.reserve(schedule.size());
+        for (const auto& [cost, game_id] : schedule) {
+            tasks.emplace_back([&play_game, &record_game, game_id]() {
+                record_game(game_id, play_game(game_id, nullptr));
+            });
+        }
+        WorkStealingPool pool(static_cast<size_t>(args.num_threads), std::move(tasks));
+        pool.run(); // the main thread only waits for the workers to join
+    }
+    if (checkpoint.isOpen()) {
+        std::cout << "Competition checkpoint: " << checkpoint.getPath() << std::endl;
+    }
+
+    // refine the per-algorithm timings with the games measured in this run
+    for (const auto& [cost, game_id] : schedule) {
+        const GameRecord& record = score_table.getRecord(game_id);
+        CachedMap map = map_cache.get(map_paths[games[game_id].map_index]);
+        if (!record.finished || record.duration_ns <= 0 || record.rounds == 0 || !map.data) {
+            continue;
+        }
+        double ns_per_unit = static_cast<double>(record.duration_ns) /
+                             (static_cast<double>(record.rounds) * GameCostModel::stepUnits(*map.data));
+        cost_model.addSample(libraries.name(algorithm_ids[record.player1_algorithm]), ns_per_unit);
+        cost_model.addSample(libraries.name(algorithm_ids[record.player2_algorithm]), ns_per_unit);
+    }
+    if (!cost_model.save()) {
+        std::cerr << "Error: could not write the competition history file." << std::endl;
+    }
+
+    // games played to the end are cached; forfeits depend on timing and crashes, so they are played again.
+    for (const auto& [cost, game_id] : schedule) {
+        const GameRecord& record = score_table.getRecord(game_id);
+        if (record.finished && !record.forfeited) {
+            result_cache.store(cache_key(game_id), CachedResult{record.winner, record.reason, record.rounds});
+        }
+    }
+    if (!result_cache.save()) {
+        std::cerr << "Error: could not write the competition result cache." << std::endl;
+    }
+
+    // a shard only holds part of the scores, they are summed up by the merge mode
+    if (shard.active()) {
+        std::vector<std::string> algorithm_names;
+        for (size_t id : algorithm_ids) {
+            algorithm_names.push_back(libraries.name(id));
+        }
+        CompetitionShard::writePartial(args.algorithms_folder, shard, args.game_maps_folder, args.game_manager_so,
+                                       algorithm_names, schedule_identity, score_table);
+        return;
+    }
+
+    std::vector<std::pair<std::string, long long>> scores;
+    for (const auto& [algorithm_index, score] : score_table.sortedScores()) {
+        scores.emplace_back(libraries.name(algorithm_ids[algorithm_index]), score);
+    }
+    GameResultWriter writer;
+    writer.writeCompetitionResults(args.algorithms_folder, args.game_maps_folder, args.game_manager_so, scores);
+}
+
+void Simulator::runMergeMode(const ParsedArgs& args) {
+    // Combines the partial result files of all shards of a competition into the final competition results.
+    std::string game_maps_folder, game_manager_so, error;
+    std::vector<std::pair<std::string, long long>> scores;
+    if (!CompetitionShard::merge(args.algorithms_folder, args.schedule, game_maps_folder, game_manager_so, scores,
+                                 args.partial_merge, error)) {
+        std::cerr << "Error: could not merge the partial results: " << error << std::endl;
+        return;
+    }
+    GameResultWriter writer;
+    writer.writeCompetitionResults(args.algorithms_folder, game_maps_folder, game_manager_so, scores);
+}
+
+void Simulator::configureGameManager(AbstractGameManager& game_manager, const ParsedArgs& args) {
+    // This function turns on the optional game manager extensions asked for on the command line
+    if (args.fast_forward) {
+        if (auto* fast_forward = dynamic_cast<FastForwardGameManager*>(&game_manager)) {
+            fast_forward->setFastForward(true);
+        }
+    }
+}
+
+GameResult Simulator::runGame(AbstractGameManager& game_manager, const MapData& map_info, const SatelliteView& satellite_view,
+                              const AlgorithmRegistrar::AlgorithmAndPlayerFactories& algorithm1,
+                              const AlgorithmRegistrar::AlgorithmAndPlayerFactories& algorithm2,
+                              const GameWatchdog* watchdog) {
+    // This function runs a single game on the given game manager with fresh player instances.
+    const size_t map_width = static_cast<size_t>(map_info.height);  // MapData::height holds the columns
+    const size_t map_height = static_cast<size_t>(map_info.length); // MapData::length holds the rows
+    const size_t max_steps = static_cast<size_t>(map_info.max_steps);
+    const size_t num_shells = static_cast<size_t>(map_info.num_shells);
+
+    auto player1 = algorithm1.createPlayer(1, map_width, map_height, max_steps, num_shells);
+    auto player2 = algorithm2.createPlayer(2, map_width, map_height, max_steps, num_shells);
+    if (watchdog) {
+        player1 = watchdog->guard(std::move(player1), 1);
+        player2 = watchdog->guard(std::move(player2), 2);
+        return game_manager.run(map_width, map_height, satellite_view, max_steps, num_shells, *player1, *player2,
+                                watchdog->guard(algorithm1.getTankAlgorithmFactory()),
+                                watchdog->guard(algorithm2.getTankAlgorithmFactory()));
+    }
+    return game_manager.run(map_width, map_height, satellite_view, max_steps, num_shells,
+                             *player1, *player2,
+                             algorithm1.getTankAlgorithmFactory(), algorithm2.getTankAlgorithmFactory());
 }
 
 
@@ -131,6 +478,7 @@ std::vector<std::string> Simulator::getAllMapNames(const std::string& folder_pat
                 map_names.push_back(entry.path().filename().string());
             }
         }
+        std::sort(map_names.begin(), map_names.end()); // directory order is unspecified, keep game ids stable
     }
     catch (const std::filesystem::filesystem_error& e) {
         std::cerr << "Error accessing folder '" << folder_path
@@ -151,7 +499,3 @@ std::vector<std::pair<int, int>> Simulator::pairs_for_map(int number_of_algorith
     }
     return std::vector<std::pair<int, int>>(uniq.begin(), uniq.end());
 }
-
-static void write_game_result_to_file(const GameResult& gameResult) {
-
-}
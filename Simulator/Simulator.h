@@ -6,6 +6,10 @@
 #include "../common/SatelliteView.h"
 #include "ArgsParser.h"
 #include "../common/GameResult.h"
+#include "../common/AbstractGameManager.h"
+#include "../UserCommon/MapData.h"
+#include "AlgorithmRegistrar.h"
+#include "GameWatchdog.h"
 
 namespace Simulator_206480972_206899163 {
 /**
@@ -16,18 +20,64 @@ public:
     Simulator();
     void run(); 
 
-    void loadSharedObjects();
-    void unloadSharedObjects();
-    
     static void runComparativeMode(const ParsedArgs& args);
     static void runCompetitionMode(const ParsedArgs& args);
+    static void runMergeMode(const ParsedArgs& args);
     static std::vector<std::string> getAllMapNames(const std::string& folder_path);
 
 private:
+    /**
+     * @brief A single scheduled competition game: a map and the two competing algorithms.
+     */
+    struct CompetitionGame {
+        size_t map_index;  ///< Index of the map in the maps folder listing
+        int player1_index; ///< Registrar index of the algorithm playing as player 1
+        int player2_index; ///< Registrar index of the algorithm playing as player 2
+    };
+
+    /**
+     * @brief A single comparative run: the game manager instance and the result it produced.
+     *        The instance is kept until the results are written, since the final state may refer to it.
+     */
+    struct ComparativeRun {
+        std::unique_ptr<AbstractGameManager> game_manager; ///< Game manager that ran the game
+        GameResult result;                                 ///< Result of the game
+    };
+
+    /**
+     * @brief Applies the game manager options of the command line that the game manager supports:
+     *        -fast_forward turns on FastForwardGameManager when it is implemented, other game managers are left as they are.
+     * @param game_manager Freshly created game manager.
+     * @param args Parsed command line arguments.
+     */
+    static void configureGameManager(AbstractGameManager& game_manager, const ParsedArgs& args);
+
+    /**
+     * @brief Runs a single game on the given game manager with freshly created player instances.
+     * @param game_manager Game manager instance to run the game on.
+     * @param map_info Parsed map of the game.
+     * @param satellite_view Satellite view over the map, used as the initial game state.
+     * @param algorithm1 Factories of the algorithm playing as player 1.
+     * @param algorithm2 Factories of the algorithm playing as player 2.
+     * @param watchdog If set, the players and tank algorithms are wrapped so the watchdog can time them.
+     * @return The result of the game.
+     */
+    static GameResult runGame(AbstractGameManager& game_manager, const MapData& map_info, const SatelliteView& satellite_view,
+                              const AlgorithmRegistrar::AlgorithmAndPlayerFactories& algorithm1,
+                              const AlgorithmRegistrar::AlgorithmAndPlayerFactories& algorithm2,
+                              const GameWatchdog* watchdog = nullptr);
+
+    /**
+     * @brief Renders a final game state into one line per board row.
+     * @param view The final state of the game.
+     * @param rows Number of rows of the board.
+     * @param cols Number of columns of the board.
+     * @return The rendered rows.
+     */
+    static std::vector<std::string> renderGameState(const SatelliteView& view, size_t rows, size_t cols);
+
     static int modp(int x, int m) { return (x % m + m) % m; }
 
     static std::vector<std::pair<int, int>> pairs_for_map(int number_of_algorithms, int number_of_maps);
-
-    static void write_game_result_to_file(const GameResult& gameResult);
 };
 } // namespace Simulator_206480972_206899163
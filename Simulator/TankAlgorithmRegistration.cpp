@@ -1,4 +1,4 @@
-#include "common/TankAlgorithmRegistration.h"
+#include "common/TankALgorithmRegistration.h"
 #include "AlgorithmRegistrar.h"
 
 
@@ -0,0 +1,93 @@
+#include "WorkStealingPool.h"
+#include <algorithm>
+#include <exception>
+#include <iostream>
+#include <thread>
+
+namespace Simulator_206480972_206899163 {
+
+WorkStealingPool::WorkStealingPool(std::size_t requested_threads, std::vector<Task>&& tasks) {
+    // A single requested thread means "main thread only"; otherwise never start more workers than tasks.
+    num_workers = (requested_threads <= 1) ? 0 : std::min(requested_threads, tasks.size());
+    std::size_t num_queues = std::max<std::size_t>(num_workers, 1);
+    queues.reserve(num_queues);
+    for (std::size_t i = 0; i < num_queues; ++i) {
+        queues.push_back(std::make_unique<WorkerQueue>());
+    }
+    for (std::size_t i = 0; i < tasks.size(); ++i) { // Deal tasks round-robin
+        queues[i % num_queues]->tasks.push_back(std::move(tasks[i]));
+    }
+}
+
+std::size_t WorkStealingPool::workerCount() const {
+    // This function returns the number of worker threads the pool starts
+    return num_workers;
+}
+
+void WorkStealingPool::run() {
+    // This function runs all tasks, either inline or on the worker threads, and waits for them to finish.
+    if (num_workers == 0) {
+        Task task;
+        while (popLocal(0, task)) {
+            runTask(task);
+        }
+        return;
+    }
+    std::vector<std::thread> workers;
+    workers.reserve(num_workers);
+    for (std::size_t i = 0; i < num_workers; ++i) {
+        workers.emplace_back(&WorkStealingPool::workerLoop, this, i);
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+}
+
+bool WorkStealingPool::popLocal(std::size_t worker, Task& task) {
+    // This function pops the next task, in submission order, from the worker's own deque
+    WorkerQueue& queue = *queues[worker];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    if (queue.tasks.empty()) {
+        return false;
+    }
+    task = std::move(queue.tasks.front());
+    queue.tasks.pop_front();
+    return true;
+}
+
+bool WorkStealingPool::steal(std::size_t thief, Task& task) {
+    // This function steals the next pending (most expensive, when submitted longest first) task of another worker
+    for (std::size_t offset = 1; offset < queues.size(); ++offset) {
+        WorkerQueue& victim = *queues[(thief + offset) % queues.size()];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (!victim.tasks.empty()) {
+            task = std::move(victim.tasks.front());
+            victim.tasks.pop_front();
+            return true;
+        }
+    }
+    return false;
+}
+
+void WorkStealingPool::workerLoop(std::size_t worker) {
+    // This function runs tasks until both the own deque and all other deques are empty.
+    // No task is added after run() starts, so an unsuccessful steal means all work is taken.
+    Task task;
+    while (popLocal(worker, task) || steal(worker, task)) {
+        runTask(task);
+    }
+}
+
+void WorkStealingPool::runTask(Task& task) {
+    // This function runs a task so that a failing game cannot take down its worker
+    try {
+        task();
+    } catch (const std::exception& e) {
+        std::cerr << "Game task failed: " << e.what() << std::endl;
+    } catch (...) {
+        std::cerr << "Game task failed with an unknown error" << std::endl;
+    }
+    task = nullptr;
+}
+
+} // namespace Simulator_206480972_206899163
@@ -0,0 +1,96 @@
+#pragma once
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+/**
+ * @file WorkStealingPool.h
+ * @brief Declares a work-stealing thread pool for running independent simulator games.
+ */
+
+namespace Simulator_206480972_206899163 {
+
+/**
+ * @class WorkStealingPool
+ * @brief Runs a fixed batch of tasks on a set of worker threads that steal work from each other.
+ *
+ * All tasks are known before the pool starts. They are dealt round-robin into one deque per worker;
+ * a worker takes tasks from the front of its own deque and, once it is empty, steals from the front of
+ * the other workers' deques. Tasks therefore start roughly in submission order, so submitting the most
+ * expensive tasks first gives longest-job-first scheduling. The pool never starts more workers than there
+ * are tasks, and with a single requested thread the tasks run inline on the calling (main) thread.
+ */
+class WorkStealingPool {
+public:
+    using Task = std::function<void()>; ///< A single unit of work (one game)
+
+    /**
+     * @brief Constructs the pool and distributes the tasks between the workers.
+     * @param requested_threads Number of worker threads requested (num_threads argument).
+     * @param tasks Tasks to run, moved into the pool.
+     */
+    WorkStealingPool(std::size_t requested_threads, std::vector<Task>&& tasks);
+
+    // Rule of 5
+    WorkStealingPool(const WorkStealingPool&) = delete;
+    WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+    WorkStealingPool(WorkStealingPool&&) noexcept = default;
+    WorkStealingPool& operator=(WorkStealingPool&&) noexcept = default;
+    ~WorkStealingPool() = default;
+
+    /**
+     * @brief Runs all tasks and returns once every task has finished.
+     *        The calling thread only waits on join while the workers run.
+     */
+    void run();
+
+    /**
+     * @brief Returns the number of worker threads the pool will start (0 means inline on the caller).
+     */
+    std::size_t workerCount() const;
+
+private:
+    /**
+     * @brief Per-worker task deque, guarded by its own mutex so that stealing never blocks the whole pool.
+     */
+    struct WorkerQueue {
+        std::mutex mutex;         ///< Guards tasks
+        std::deque<Task> tasks;   ///< Tasks owned by this worker
+    };
+
+    std::size_t num_workers;                          ///< Number of worker threads to start
+    std::vector<std::unique_ptr<WorkerQueue>> queues; ///< One deque per worker
+
+    /**
+     * @brief Pops the next task from the front of the worker's own deque.
+     * @param worker Index of the worker.
+     * @param task Output parameter for the popped task.
+     * @return True if a task was popped.
+     */
+    bool popLocal(std::size_t worker, Task& task);
+
+    /**
+     * @brief Steals the next pending task from the front of another worker's deque.
+     * @param thief Index of the stealing worker.
+     * @param task Output parameter for the stolen task.
+     * @return True if a task was stolen.
+     */
+    bool steal(std::size_t thief, Task& task);
+
+    /**
+     * @brief Main loop of a worker: drain the own deque, then steal until no work is left anywhere.
+     * @param worker Index of the worker.
+     */
+    void workerLoop(std::size_t worker);
+
+    /**
+     * @brief Runs a single task, reporting (and swallowing) any exception it throws.
+     * @param task The task to run.
+     */
+    static void runTask(Task& task);
+};
+
+} // namespace Simulator_206480972_206899163
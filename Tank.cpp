@@ -10,7 +10,8 @@
 
 // Constructor 
 Tank::Tank(int x, int y, int id, int player_index, int ammo_count)
-    : position(x, y),
+    : GameObject(Type::Tank),
+      position(x, y),
       id(id),
       canon_dir(player_index == 1 ? Direction::L : Direction::R),
       player_index(player_index),
@@ -87,11 +88,17 @@ void Tank::IncreaseBackwardSteps() {
     }
 }
 
-void Tank::cooldownModify() {
+int Tank::cooldownAfterStep(int cooldown) {
     // Decreases the shooting cooldown if it's greater than 0 and less than 5
-    if (this->shooting_cooldown < 5 && this->shooting_cooldown > 0) {
-        this->shooting_cooldown--;
-    } 
+    if (cooldown < 5 && cooldown > 0) {
+        return cooldown - 1;
+    }
+    return cooldown;
+}
+
+void Tank::cooldownModify() {
+    // Applies the cooldown rule of a single step
+    this->shooting_cooldown = cooldownAfterStep(this->shooting_cooldown);
 }
 
 void Tank::setBackwardSteps(int steps) {
@@ -172,6 +179,23 @@ bool Tank::canShoot() const {
     return ammo_count > 0 && shooting_cooldown == 0;
 }
 
+bool Tank::canEverShoot() const {
+    // Runs the cooldown down with the rule of cooldownModify; a cooldown the rule does not lower never runs out
+    // (today the cooldown of 5 set by a shot). The cooldown falls every round, so this ends.
+    if (ammo_count <= 0) {
+        return false;
+    }
+    int cooldown = shooting_cooldown;
+    while (cooldown > 0) {
+        const int next = cooldownAfterStep(cooldown);
+        if (next >= cooldown) {
+            return false;
+        }
+        cooldown = next;
+    }
+    return true;
+}
+
 void Tank::printFutureSteps(const Tank* tank) { 
     // Print future steps for a tank
     const std::vector<Point>& futureSteps = tank->getFutureSteps();
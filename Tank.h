@@ -24,6 +24,12 @@ private:
     bool is_alive = true;          ///< Flag indicating if the tank is alive.
     std::vector<Point> future_steps; ///< Predicted future steps for the tank.
 
+    /**
+     * @brief Returns the shooting cooldown after cooldownModify, the single rule both it and canEverShoot follow.
+     * @param cooldown The cooldown before the step.
+     */
+    static int cooldownAfterStep(int cooldown);
+
 public:
     /**
      * @brief Constructs a Tank object.
@@ -188,6 +194,13 @@ public:
      */
     bool canShoot() const; 
 
+    /**
+     * @brief Checks if the tank may shoot again in the rest of the game, with the cooldown run down by cooldownModify.
+     *        It applies the same rule as cooldownModify until the cooldown reaches 0 or stops changing.
+     * @return False if the tank has no ammo or its cooldown is one cooldownModify never runs down, true otherwise.
+     */
+    bool canEverShoot() const;
+
     /**
      * @brief Decrements the shooting cooldown.
      */
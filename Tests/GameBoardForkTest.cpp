@@ -0,0 +1,253 @@
+#include "GameBoard.h"
+#include "GameBoardSatelliteView.h"
+#include "UserCommon/MapData.h"
+#include <algorithm>
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <span>
+#include <string>
+#include <utility>
+#include <vector>
+
+// Checks GameBoard::fork: an untouched fork matches its board, changes to tanks, shells, walls and mines on either
+// side do not show on the other, the tanks of both boards line up in getPlayerTanks, and a wall or mine pointer taken
+// before the terrain was copied still acts on the board it is passed to.
+//
+// Usage: game_board_fork_test (exits with 1 if any check failed)
+
+namespace {
+
+const std::vector<std::string> kLayout = {
+    "1  #   @  ",
+    "   #      ",
+    "  *       ",
+    "       2  ",
+    "#     @   ",
+    "   1    2 ",
+    "          ",
+    "     #    ",
+};
+
+int failures = 0; ///< Number of failed checks
+
+/**
+ * @brief Records a failed check.
+ * @param condition Whether the check passed.
+ * @param what Description of the check, printed when it failed.
+ */
+void expect(bool condition, const std::string& what) {
+    if (!condition) {
+        std::cerr << "game_board_fork_test: " << what << "\n";
+        ++failures;
+    }
+}
+
+/**
+ * @brief Builds a board from kLayout, the way the game manager does.
+ */
+std::unique_ptr<GameBoard> makeBoard() {
+    std::vector<std::vector<char>> grid;
+    for (const std::string& row : kLayout) {
+        grid.emplace_back(row.begin(), row.end());
+    }
+    const size_t rows = kLayout.size();
+    const size_t cols = kLayout.front().size();
+    MapData map(100, 10, static_cast<int>(rows), static_cast<int>(cols), std::move(grid));
+    GameBoardSatelliteView view(&map);
+    return std::make_unique<GameBoard>(cols, rows, view, 100, 10);
+}
+
+/**
+ * @brief Returns whether both boards show the same character in every cell.
+ * @param a First board.
+ * @param b Second board, of the same size.
+ */
+bool sameCells(const GameBoard& a, const GameBoard& b) {
+    for (int row = 0; row < a.getRows(); ++row) {
+        std::span<const char> a_row = a.getCharRow(row);
+        std::span<const char> b_row = b.getCharRow(row);
+        if (!std::equal(a_row.begin(), a_row.end(), b_row.begin(), b_row.end())) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Checks that the tanks of the fork are copies of the board's tanks at the same indices of getPlayerTanks.
+ * @param board The forked board.
+ * @param copy The fork.
+ * @param when Case name for the messages.
+ */
+void checkTanksLineUp(GameBoard& board, GameBoard& copy, const std::string& when) {
+    for (int player = 1; player <= 2; ++player) {
+        const std::vector<Tank*>& tanks = board.getPlayerTanks(player);
+        const std::vector<Tank*>& copied = copy.getPlayerTanks(player);
+        expect(tanks.size() == copied.size(), when + ": player " + std::to_string(player) + " has another tank count");
+        for (size_t i = 0; i < std::min(tanks.size(), copied.size()); ++i) {
+            const std::string tank = when + ": tank " + std::to_string(i) + " of player " + std::to_string(player);
+            expect(tanks[i] != copied[i], tank + " is shared, not copied");
+            expect(tanks[i]->getId() == copied[i]->getId() && tanks[i]->getPosition() == copied[i]->getPosition() &&
+                       tanks[i]->getCanonDir() == copied[i]->getCanonDir() &&
+                       tanks[i]->getAmmoCount() == copied[i]->getAmmoCount(),
+                   tank + " is not at its index");
+            expect(board.isObjectOnBoard(tanks[i]) == copy.isObjectOnBoard(copied[i]), tank + " is on only one board");
+            expect(!copy.isObjectOnBoard(copied[i]) || copy.getObjectAt(copied[i]->getPosition()) == copied[i],
+                   tank + " is not in its cell of the fork");
+        }
+    }
+}
+
+/**
+ * @brief A fork of a board with a removed tank matches the board, and so does a fork of the fork.
+ */
+void checkUntouchedFork() {
+    auto board = makeBoard();
+    board->removeTank(board->getPlayerTanks(2)[1]); // removed tanks are copied too
+    auto copy = board->fork();
+    expect(copy->stateHash() == board->stateHash(), "untouched fork: state hashes differ");
+    expect(sameCells(*board, *copy), "untouched fork: cells differ");
+    expect(copy->getShells().size() == 1 && copy->getWalls().size() == 4 && copy->getMines().size() == 2,
+           "untouched fork: shells, walls or mines are missing");
+    checkTanksLineUp(*board, *copy, "untouched fork");
+    auto snapshot = copy->fork();
+    expect(snapshot->stateHash() == board->stateHash(), "fork of a fork: state hashes differ");
+}
+
+/**
+ * @brief Moves, turns, unloads and removes tanks on one side and checks the other.
+ */
+void checkTanks() {
+    for (bool change_fork : {true, false}) {
+        const std::string side = change_fork ? "tank changed on the fork" : "tank changed on the board";
+        auto board = makeBoard();
+        auto copy = board->fork();
+        const std::uint64_t hash = board->stateHash();
+        GameBoard& changed = change_fork ? *copy : *board;
+        GameBoard& other = change_fork ? *board : *copy;
+        Tank* tank = changed.getPlayerTanks(1)[0];
+        const Point from = tank->getPosition();
+        tank->rotateRight(2);
+        tank->moveForward(changed.getCols(), changed.getRows());
+        changed.moveObject(tank, from);
+        tank->setAmmoCount(3);
+        changed.removeTank(changed.getPlayerTanks(2)[0]);
+
+        Tank* other_tank = other.getPlayerTanks(1)[0];
+        expect(other_tank->getPosition() == from && other_tank->getAmmoCount() == 10, side + ": the other tank changed");
+        expect(other.getCharAt(from) == '1' && other.getCharAt(tank->getPosition()) == ' ', side + ": the other cells changed");
+        expect(other.isObjectOnBoard(other.getPlayerTanks(2)[0]) && other.getAllTanks().size() == 4,
+               side + ": the removal shows on the other board");
+        expect(other.stateHash() == hash, side + ": the other state hash changed");
+        expect(changed.stateHash() != hash, side + ": the state hash did not change");
+        expect(changed.getCharAt(tank->getPosition()) == '1' && changed.getCharAt(from) == ' ',
+               side + ": the tank did not move to its new cell");
+    }
+}
+
+/**
+ * @brief Moves, adds and removes shells on one side and checks the other.
+ */
+void checkShells() {
+    for (bool change_fork : {true, false}) {
+        const std::string side = change_fork ? "shells changed on the fork" : "shells changed on the board";
+        auto board = makeBoard();
+        auto copy = board->fork();
+        const std::uint64_t hash = board->stateHash();
+        GameBoard& changed = change_fork ? *copy : *board;
+        GameBoard& other = change_fork ? *board : *copy;
+        Shell* shell = changed.getShells()[0];
+        const Point from = shell->getPosition();
+        shell->move(changed.getCols(), changed.getRows());
+        changed.moveObject(shell, from);
+        changed.addShell(Shell(Point(6, 6), Direction::L, 0));
+
+        expect(other.getShells().size() == 1 && other.getShells()[0]->getPosition() == from,
+               side + ": the other shells changed");
+        expect(other.getCharAt(from) == '*' && other.getCharAt(Point(6, 6)) == ' ', side + ": the other cells changed");
+        expect(other.stateHash() == hash, side + ": the other state hash changed");
+        changed.removeShell(changed.getShells()[0]);
+        changed.removeShell(changed.getShells()[0]);
+        expect(changed.getShells().empty() && other.getShells().size() == 1, side + ": removing shells leaked");
+    }
+}
+
+/**
+ * @brief Hits and destroys a wall on one side, through a pointer taken before the fork, and checks both sides.
+ */
+void checkWalls() {
+    for (bool change_fork : {true, false}) {
+        const std::string side = change_fork ? "wall hit on the fork" : "wall hit on the board";
+        auto board = makeBoard();
+        Wall* wall = board->getWalls()[0]; // taken while the terrain is not shared yet
+        const Point pos = wall->getPosition();
+        auto copy = board->fork();
+        const std::uint64_t hash = board->stateHash();
+        GameBoard& changed = change_fork ? *copy : *board;
+        GameBoard& other = change_fork ? *board : *copy;
+
+        changed.hitWall(wall);
+        expect(changed.isDamagedWallAt(pos), side + ": the wall is not damaged");
+        expect(other.isWallAt(pos) && !other.isDamagedWallAt(pos), side + ": the other wall is damaged");
+        expect(other.getWallAt(pos)->getHitCount() == 0, side + ": the other wall counts the hit");
+        expect(other.stateHash() == hash && changed.stateHash() != hash, side + ": state hashes are wrong");
+
+        // the pointer from before the copy still acts on the board it is passed to
+        changed.hitWall(wall);
+        expect(!changed.isWallAt(pos) && changed.getWalls().size() == 3, side + ": the wall was not destroyed");
+        expect(other.isWallAt(pos) && other.getWalls().size() == 4 && other.getCharAt(pos) == '#',
+               side + ": destroying the wall leaked");
+        other.hitWall(wall);
+        expect(other.isDamagedWallAt(pos) && !changed.isWallAt(pos), side + ": hitting the other wall leaked");
+    }
+
+    // the same hit on both boards gives the same state again
+    auto board = makeBoard();
+    auto copy = board->fork();
+    Wall* wall = board->getWalls()[1];
+    copy->hitWall(wall);
+    board->hitWall(wall);
+    expect(board->stateHash() == copy->stateHash() && sameCells(*board, *copy), "same wall hit on both: boards differ");
+}
+
+/**
+ * @brief Removes a mine on one side, through a pointer taken before the fork, and checks both sides.
+ */
+void checkMines() {
+    for (bool change_fork : {true, false}) {
+        const std::string side = change_fork ? "mine removed on the fork" : "mine removed on the board";
+        auto board = makeBoard();
+        Mine* mine = board->getMines()[0]; // taken while the terrain is not shared yet
+        const Point pos = mine->getPosition();
+        auto copy = board->fork();
+        const std::uint64_t hash = board->stateHash();
+        GameBoard& changed = change_fork ? *copy : *board;
+        GameBoard& other = change_fork ? *board : *copy;
+
+        changed.removeMine(mine);
+        expect(!changed.isMineAt(pos) && changed.getMines().size() == 1, side + ": the mine was not removed");
+        expect(other.isMineAt(pos) && other.getMineAt(pos) != nullptr && other.getMines().size() == 2 &&
+                   other.getCharAt(pos) == '@',
+               side + ": the removal leaked");
+        expect(other.stateHash() == hash && changed.stateHash() != hash, side + ": state hashes are wrong");
+        other.removeMine(mine);
+        expect(!other.isMineAt(pos) && other.getMines().size() == 1, side + ": the other mine was not removed");
+    }
+}
+
+} // namespace
+
+int main() {
+    checkUntouchedFork();
+    checkTanks();
+    checkShells();
+    checkWalls();
+    checkMines();
+    if (failures > 0) {
+        std::cerr << "game_board_fork_test: FAILED\n";
+        return 1;
+    }
+    std::cout << "game_board_fork_test: tanks, shells, walls and mines stay apart across forks\n";
+    return 0;
+}
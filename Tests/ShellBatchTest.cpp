@@ -0,0 +1,108 @@
+#include "ShellBatch.h"
+#include "Shell.h"
+#include <algorithm>
+#include <iostream>
+#include <utility>
+#include <vector>
+
+// Checks ShellBatch::advance and ShellBatch::advanceScalar against Shell::move: every position and direction of
+// small boards, including single row and single column boards, in batches smaller than, equal to and larger than
+// the four shells of the SSE2 loop, so both the vector loop and the scalar tail are covered.
+//
+// Usage: shell_batch_test (exits with 1 on the first board with a mismatch)
+
+namespace {
+
+const Direction kDirections[] = {Direction::U, Direction::UR, Direction::R, Direction::DR,
+                                 Direction::D, Direction::DL, Direction::L, Direction::UL};
+
+const size_t kBatchSizes[] = {1, 2, 3, 4, 5, 7, 8, 9}; ///< Around the four shells of the SSE2 loop
+
+/**
+ * @brief A shell to move: its start position and direction.
+ */
+struct ShellCase {
+    Point position;      ///< Start position
+    Direction direction; ///< Direction of the shell
+};
+
+/**
+ * @brief Moves the shells through a batch of every size in kBatchSizes and compares them with Shell::move.
+ * @param rows Number of rows on the board.
+ * @param cols Number of columns on the board.
+ * @return The number of mismatches, each one is printed.
+ */
+int checkBoard(int rows, int cols) {
+    std::vector<ShellCase> cases;
+    for (int x = 0; x < rows; ++x) {
+        for (int y = 0; y < cols; ++y) {
+            for (Direction direction : kDirections) {
+                cases.push_back(ShellCase{Point(x, y), direction});
+            }
+        }
+    }
+    std::vector<Point> expected;
+    for (const ShellCase& shell_case : cases) {
+        Shell shell(shell_case.position, shell_case.direction, 0);
+        shell.move(cols, rows);
+        expected.push_back(shell.getPosition());
+    }
+
+    int mismatches = 0;
+    auto compare = [&](const char* method, size_t batch_size, const ShellBatch& batch, size_t first) {
+        for (size_t i = 0; i < batch.size(); ++i) {
+            if (batch.position(i) == expected[first + i]) {
+                continue;
+            }
+            const ShellCase& shell_case = cases[first + i];
+            std::cerr << method << " on " << rows << "x" << cols << " (batch of " << batch_size << "): shell at ("
+                      << shell_case.position.getX() << "," << shell_case.position.getY() << ") moving "
+                      << directionToString(shell_case.direction) << " ended at (" << batch.position(i).getX() << ","
+                      << batch.position(i).getY() << "), expected (" << expected[first + i].getX() << ","
+                      << expected[first + i].getY() << ")\n";
+            ++mismatches;
+        }
+    };
+    ShellBatch vector_batch;
+    ShellBatch scalar_batch;
+    for (size_t batch_size : kBatchSizes) {
+        for (size_t first = 0; first < cases.size(); first += batch_size) {
+            vector_batch.clear();
+            scalar_batch.clear();
+            for (size_t i = first; i < std::min(first + batch_size, cases.size()); ++i) {
+                vector_batch.add(cases[i].position, cases[i].direction);
+                scalar_batch.add(cases[i].position, cases[i].direction);
+            }
+            vector_batch.advance(rows, cols);
+            scalar_batch.advanceScalar(rows, cols);
+            compare("advance", batch_size, vector_batch, first);
+            compare("advanceScalar", batch_size, scalar_batch, first);
+        }
+    }
+    return mismatches;
+}
+
+} // namespace
+
+int main() {
+    std::vector<std::pair<int, int>> boards;
+    for (int rows = 1; rows <= 6; ++rows) {
+        for (int cols = 1; cols <= 6; ++cols) {
+            boards.emplace_back(rows, cols);
+        }
+    }
+    for (int size = 7; size <= 12; ++size) {
+        boards.emplace_back(1, size);
+        boards.emplace_back(size, 1);
+    }
+    boards.emplace_back(9, 13);
+
+    for (const auto& [rows, cols] : boards) {
+        if (checkBoard(rows, cols) > 0) {
+            std::cerr << "shell_batch_test: FAILED\n";
+            return 1;
+        }
+    }
+    std::cout << "shell_batch_test: " << boards.size() << " boards passed\n";
+    return 0;
+}
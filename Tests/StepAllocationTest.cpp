@@ -0,0 +1,178 @@
+#include "GameBoardSatelliteView.h"
+#include "GameManager.h"
+#include "UserCommon/BulkSatelliteView.h"
+#include "UserCommon/MapData.h"
+#include "common/BattleInfo.h"
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <new>
+#include <vector>
+
+// Checks that the game loop reuses its scratch buffers: plays a scripted game (moves forward and backward, turns,
+// battle info through the game's satellite view, shots) and counts the calls to operator new of every step. Once the
+// buffers reached their size in the first kWarmUpSteps steps, no step may allocate.
+//
+// Usage: step_allocation_test (exits with 1 if a step after the warm-up allocated)
+
+namespace {
+
+constexpr size_t kMaxSteps = 1000;  ///< Steps of the scripted game
+constexpr size_t kWarmUpSteps = 50; ///< Steps in which the scratch buffers may still grow
+
+size_t allocations = 0;                      ///< Number of calls to operator new so far
+size_t allocations_at_step[kMaxSteps + 1];   ///< Value of allocations when the step started, fixed size so it never allocates
+size_t steps_started = 0;                    ///< Number of steps that called getAction so far
+size_t battle_infos = 0;                     ///< Number of battle infos the tanks got
+size_t bad_views = 0;                        ///< Battle infos in which the requesting tank was not seen exactly once
+size_t moves_seen = 0;                       ///< Battle infos that showed the tank away from where the previous one did
+
+/**
+ * @brief Board as the player read it, handed to the tank algorithm. The buffer is sized up front, so reading it
+ *        never allocates.
+ */
+struct ScriptedBattleInfo : public BattleInfo {
+    std::vector<char> cells; ///< The board, row after row
+    size_t own_tanks = 0;    ///< Number of '%' cells (the requesting tank) the player saw
+    size_t own_cell = 0;     ///< Index in cells of the last '%' cell
+};
+
+/**
+ * @brief Tank algorithm with a fixed script that does not allocate: it drives forward and backward, turns, asks
+ *        for battle info and now and then shoots. The first algorithm called in a step records the allocation
+ *        count at its start.
+ */
+class ScriptedTankAlgorithm : public TankAlgorithm {
+    size_t step = 0;      ///< Step of the next getAction call
+    int offset;           ///< Shifts the script, so the tanks do not move in lockstep
+    size_t last_cell = 0; ///< Cell of the tank in the previous battle info, 0 before the first one
+public:
+    explicit ScriptedTankAlgorithm(int offset) : offset(offset) {}
+
+    ActionRequest getAction() override {
+        if (step == steps_started && step <= kMaxSteps) {
+            allocations_at_step[steps_started++] = allocations;
+        }
+        static const ActionRequest kScript[] = {
+            ActionRequest::MoveForward, ActionRequest::MoveForward, ActionRequest::RotateRight45, ActionRequest::GetBattleInfo,
+            ActionRequest::MoveBackward, ActionRequest::MoveBackward, ActionRequest::MoveBackward, ActionRequest::MoveBackward,
+            ActionRequest::RotateLeft90, ActionRequest::MoveForward, ActionRequest::GetBattleInfo, ActionRequest::DoNothing,
+            ActionRequest::RotateRight90, ActionRequest::MoveBackward, ActionRequest::MoveForward, ActionRequest::RotateLeft45};
+        const size_t script_step = step++ + static_cast<size_t>(offset);
+        if (script_step % 32 == 5) {
+            return ActionRequest::Shoot;
+        }
+        return kScript[script_step % 16];
+    }
+
+    void updateBattleInfo(BattleInfo& info) override {
+        const auto& board = static_cast<ScriptedBattleInfo&>(info);
+        ++battle_infos;
+        // the player saw exactly the requesting tank as its own tank, in the bulk copy as well
+        if (board.own_tanks != 1 || board.cells[board.own_cell] != '%') {
+            ++bad_views;
+            return;
+        }
+        if (last_cell != 0 && board.own_cell != last_cell) {
+            ++moves_seen;
+        }
+        last_cell = board.own_cell;
+    }
+};
+
+/**
+ * @brief Player that reads the whole satellite view it gets, in bulk and cell by cell, into a buffer sized up front,
+ *        and hands it to the tank.
+ */
+class ScriptedPlayer : public Player {
+    size_t rows;             ///< Rows of the board
+    size_t cols;             ///< Columns of the board
+    ScriptedBattleInfo info; ///< Reused for every update
+public:
+    ScriptedPlayer(size_t rows, size_t cols) : rows(rows), cols(cols) { info.cells.resize(rows * cols); }
+
+    void updateTankWithBattleInfo(TankAlgorithm& tank, SatelliteView& satellite_view) override {
+        if (const auto* bulk = dynamic_cast<const BulkSatelliteView*>(&satellite_view)) {
+            bulk->copyRows(info.cells.data(), cols, rows, cols);
+        }
+        info.own_tanks = 0;
+        for (size_t x = 0; x < rows; ++x) {
+            for (size_t y = 0; y < cols; ++y) {
+                if (satellite_view.getObjectAt(x, y) == '%') {
+                    ++info.own_tanks;
+                    info.own_cell = x * cols + y;
+                }
+            }
+        }
+        tank.updateBattleInfo(info);
+    }
+};
+
+} // namespace
+
+void* operator new(std::size_t size) {
+    ++allocations;
+    if (void* memory = std::malloc(size != 0 ? size : 1)) {
+        return memory;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* memory) noexcept {
+    std::free(memory);
+}
+
+void operator delete(void* memory, std::size_t) noexcept {
+    std::free(memory);
+}
+
+int main() {
+    // two tanks per player on a 20x30 board with a few walls and a mine
+    std::vector<std::vector<char>> grid(20, std::vector<char>(30, ' '));
+    for (int row = 0; row < 20; row += 4) {
+        grid[row][(row * 7) % 30] = '#';
+    }
+    grid[10][3] = '@';
+    grid[2][2] = '1';
+    grid[17][25] = '1';
+    grid[5][20] = '2';
+    grid[15][8] = '2';
+    MapData map(static_cast<int>(kMaxSteps), 1000, 20, 30, std::move(grid));
+    GameBoardSatelliteView view(&map);
+    ScriptedPlayer player1(20, 30);
+    ScriptedPlayer player2(20, 30);
+    GameManager_206480972_206899163::GameManager game_manager(false);
+    GameResult result = game_manager.run(30, 20, view, kMaxSteps, 1000, player1, player2,
+                                         [](int, int) { return std::make_unique<ScriptedTankAlgorithm>(0); },
+                                         [](int, int) { return std::make_unique<ScriptedTankAlgorithm>(3); });
+
+    if (steps_started < kWarmUpSteps * 4) {
+        std::cerr << "step_allocation_test: the scripted game ended after " << steps_started << " steps, too early to check\n";
+        return 1;
+    }
+    size_t failed_steps = 0;
+    if (bad_views > 0) {
+        std::cerr << "step_allocation_test: " << bad_views << " battle infos did not show the requesting tank once\n";
+        ++failed_steps;
+    }
+    if (battle_infos == 0 || moves_seen == 0) {
+        std::cerr << "step_allocation_test: the script got " << battle_infos << " battle infos and saw " << moves_seen
+                  << " moves, it no longer covers them\n";
+        ++failed_steps;
+    }
+    for (size_t step = kWarmUpSteps; step + 1 < steps_started; ++step) {
+        const size_t count = allocations_at_step[step + 1] - allocations_at_step[step];
+        if (count > 0) {
+            std::cerr << "step_allocation_test: step " << step << " allocated " << count << " times\n";
+            ++failed_steps;
+        }
+    }
+    if (failed_steps > 0) {
+        std::cerr << "step_allocation_test: FAILED\n";
+        return 1;
+    }
+    std::cout << "step_allocation_test: no allocations in steps " << kWarmUpSteps << " to " << steps_started - 1
+              << " of a game of " << result.rounds << " rounds (" << battle_infos << " battle infos, " << moves_seen
+              << " moves seen)\n";
+    return 0;
+}
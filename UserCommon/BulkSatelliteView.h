@@ -0,0 +1,26 @@
+#pragma once
+
+#include <cstddef> // for size_t
+
+/**
+ * @class BulkSatelliteView
+ * @brief Optional extension of SatelliteView for views that can hand out the whole board at once.
+ *
+ * A view implements it next to SatelliteView. Readers detect it with dynamic_cast and read the board
+ * with one call; views that only implement SatelliteView are still read cell by cell through getObjectAt.
+ * Rows and columns are those of the board, whatever (x, y) order the view uses in getObjectAt.
+ */
+class BulkSatelliteView {
+public:
+    virtual ~BulkSatelliteView() = default;
+
+    /**
+     * @brief Copies the top left rows x cols cells of the board into dst, one row after the other.
+     *        Every character is the one getObjectAt returns for the cell; cells outside the board read '&'.
+     * @param dst Destination buffer, row r starts at dst + r * stride.
+     * @param stride Distance between the starts of two rows in dst, at least cols.
+     * @param rows Number of rows to copy.
+     * @param cols Number of columns to copy.
+     */
+    virtual void copyRows(char* dst, size_t stride, size_t rows, size_t cols) const = 0;
+};
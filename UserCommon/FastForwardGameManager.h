@@ -0,0 +1,24 @@
+#pragma once
+
+/**
+ * @class FastForwardGameManager
+ * @brief Optional extension of AbstractGameManager for game managers that can skip the rest of a game stuck in a cycle
+ *        or whose tie is already decided.
+ *
+ * The simulator detects it with dynamic_cast and turns it on when asked to; game managers that only
+ * implement AbstractGameManager always play every step.
+ */
+class FastForwardGameManager {
+public:
+    virtual ~FastForwardGameManager() = default;
+
+    /**
+     * @brief Turns fast forward on or off for the following games. When it is on and the whole game state,
+     *        including every player and tank algorithm (see StateHashable), repeats, the repeated cycles up to
+     *        MaxSteps are skipped and the result is the one the full game would reach. A game that can no longer end other
+     *        than in a tie ends as soon as that is proven, with the winner, reason, rounds and remaining tanks of the full game;
+     *        its final state is the board at the step of the proof.
+     * @param enabled Whether repeated cycles are skipped.
+     */
+    virtual void setFastForward(bool enabled) = 0;
+};
@@ -1,5 +1,6 @@
 #pragma once 
 
+#include <utility>
 #include <vector>
 /**
  * @struct MapData
@@ -13,5 +14,5 @@ struct MapData {
     std::vector<std::vector<char>> grid;    ///< 2D vector representing the map layout
 
     MapData(int max_steps, int num_shells, int length, int height, std::vector<std::vector<char>>&& grid)
-        : max_steps(max_steps), num_shells(num_shells), length(length), height(height), grid(grid) {}
+        : max_steps(max_steps), num_shells(num_shells), length(length), height(height), grid(std::move(grid)) {}
 };
@@ -0,0 +1,36 @@
+#pragma once
+
+#include <cstdint>
+
+/**
+ * @brief Mixes a value into a running state hash (splitmix64 finalizer over seed and value).
+ * @param seed The hash so far.
+ * @param value The value to add.
+ * @return The combined hash; the order of the values matters.
+ */
+inline std::uint64_t combineStateHash(std::uint64_t seed, std::uint64_t value) {
+    std::uint64_t z = seed + 0x9e3779b97f4a7c15ULL + value * 0xbf58476d1ce4e5b9ULL;
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+    return z ^ (z >> 31);
+}
+
+/**
+ * @class StateHashable
+ * @brief Optional extension of TankAlgorithm and Player for objects that can hash their internal state.
+ *
+ * A tank algorithm or player implements it next to its base class, and the game manager detects it with dynamic_cast.
+ * Implementing it is a promise: once stateHash returns a value it returned before, the object answers the same
+ * calls with the same arguments exactly as it did then, so nothing it depends on (a step counter, a clock,
+ * a random generator) may be left out of the hash. A game manager only skips repeated steps when every
+ * player and tank algorithm of the game makes that promise.
+ */
+class StateHashable {
+public:
+    virtual ~StateHashable() = default;
+
+    /**
+     * @brief Returns a hash of everything the object's future behaviour depends on.
+     */
+    virtual std::uint64_t stateHash() const = 0;
+};
@@ -1,7 +1,7 @@
 #include "Wall.h"
 
 // Constructs a Wall at the given (x, y) position, initializing hit count to 0.
-Wall::Wall(int x, int y) : position(x, y), cnt_hits(0) {}
+Wall::Wall(int x, int y) : GameObject(Type::Wall), position(x, y), cnt_hits(0) {}
 
 // Returns the position of the wall.
 Point Wall::getPosition() const {
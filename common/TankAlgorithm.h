@@ -2,6 +2,7 @@
 #include "ActionRequest.h"
 #include "BattleInfo.h"
 #include <functional>
+#include <memory>
 
 class TankAlgorithm {
 public: